@@ -0,0 +1,116 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "BA_FMoments.h"
+
+#pragma region FBA_FMoments
+
+void FBA_FMoments::Add(double Value, int64 ValueCount)
+{
+	if (ValueCount <= 0)
+	{
+		return;
+	}
+	if (ValueCount > 1)
+	{
+		// identical values have no spread of their own
+		FBA_FMoments Block;
+		Block.Count = ValueCount;
+		Block.Mean = Value;
+		Combine(Block);
+		return;
+	}
+	const double N1 = static_cast<double>(Count);
+	Count++;
+	const double N = static_cast<double>(Count);
+	const double Delta = Value - Mean;
+	const double DeltaN = Delta / N;
+	const double Term = Delta * DeltaN * N1;
+	Mean += DeltaN;
+	M3 += Term * DeltaN * (N - 2) - 3 * DeltaN * M2;
+	M2 += Term;
+}
+
+bool FBA_FMoments::Remove(double Value)
+{
+	if (Count <= 1)
+	{
+		const bool bRemoved = Count == 1;
+		Reset();
+		return bRemoved;
+	}
+	// Add run backwards: Delta was the difference to the mean before Value was added
+	const double N = static_cast<double>(Count);
+	const double Delta = (Value - Mean) * N / (N - 1);
+	const double DeltaN = Delta / N;
+	const double Term = Delta * DeltaN * (N - 1);
+	Mean -= DeltaN;
+	M2 = FMath::Max(M2 - Term, 0.0);
+	M3 -= Term * DeltaN * (N - 2) - 3 * DeltaN * M2;
+	Count--;
+	return true;
+}
+
+void FBA_FMoments::Combine(const FBA_FMoments& Other)
+{
+	if (Other.Count == 0)
+	{
+		return;
+	}
+	if (Count == 0)
+	{
+		*this = Other;
+		return;
+	}
+	const double NA = static_cast<double>(Count);
+	const double NB = static_cast<double>(Other.Count);
+	const double N = NA + NB;
+	const double Delta = Other.Mean - Mean;
+	const double DeltaN = Delta / N;
+	M3 += Other.M3 + Delta * DeltaN * DeltaN * NA * NB * (NA - NB) + 3 * DeltaN * (NA * Other.M2 - NB * M2);
+	M2 += Other.M2 + Delta * DeltaN * NA * NB;
+	Mean += DeltaN * NB;
+	Count += Other.Count;
+}
+
+void FBA_FMoments::Reset()
+{
+	Count = 0;
+	Mean = 0;
+	M2 = 0;
+	M3 = 0;
+}
+
+double FBA_FMoments::GetVariance() const
+{
+	return Count > 0 ? M2 / Count : 0;
+}
+
+double FBA_FMoments::GetStandardDeviation() const
+{
+	return FMath::Sqrt(GetVariance());
+}
+
+double FBA_FMoments::GetSkewness() const
+{
+	// zero for a single value or identical values
+	if (Count < 2 || M2 <= UE_DOUBLE_SMALL_NUMBER)
+	{
+		return 0;
+	}
+	return FMath::Sqrt(static_cast<double>(Count)) * M3 / FMath::Pow(M2, 1.5);
+}
+
+#pragma endregion
+
+#pragma region FBA_FCompensatedSum
+
+void FBA_FCompensatedSum::Add(double Value)
+{
+	const double NewTotal = Total + Value;
+	Compensation += FMath::Abs(Total) >= FMath::Abs(Value)
+		? (Total - NewTotal) + Value
+		: (Value - NewTotal) + Total;
+	Total = NewTotal;
+}
+
+#pragma endregion
@@ -0,0 +1,158 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "BA_FObjectCache.h"
+
+#pragma region Cache Access
+
+void FBA_FObjectCache::SetCapacity(int32 NewCapacity)
+{
+	Capacity = FMath::Max(0, NewCapacity);
+	while (GuidToSlot.Num() > Capacity && Oldest != INDEX_NONE)
+	{
+		RemoveSlot(Oldest);
+	}
+}
+
+UObject* FBA_FObjectCache::Find(const FGuid& InstanceGuid, int32 PayloadRevision, int32& PatchRevision)
+{
+	const int32* SlotPtr = GuidToSlot.Find(InstanceGuid);
+	if (!SlotPtr)
+	{
+		return nullptr;
+	}
+	const int32 Slot = *SlotPtr;
+	if (Slots[Slot].PayloadRevision != PayloadRevision || !IsValid(Slots[Slot].Object))
+	{
+		RemoveSlot(Slot);
+		return nullptr;
+	}
+	if (Slot != Newest)
+	{
+		Unlink(Slot);
+		LinkAsNewest(Slot);
+	}
+	PatchRevision = Slots[Slot].PatchRevision;
+	return Slots[Slot].Object;
+}
+
+void FBA_FObjectCache::Add(const FGuid& InstanceGuid, UObject* Object, int32 PayloadRevision, int32 PatchRevision)
+{
+	if (Capacity <= 0 || !IsValid(Object))
+	{
+		return;
+	}
+	Invalidate(InstanceGuid);
+	if (GuidToSlot.Num() >= Capacity)
+	{
+		RemoveSlot(Oldest);
+	}
+
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = Slots.AddDefaulted();
+	}
+	FBA_FCachedObject& CachedObject = Slots[Slot];
+	CachedObject.InstanceGuid = InstanceGuid;
+	CachedObject.Object = Object;
+	CachedObject.PayloadRevision = PayloadRevision;
+	CachedObject.PatchRevision = PatchRevision;
+	LinkAsNewest(Slot);
+	GuidToSlot.Add(InstanceGuid, Slot);
+}
+
+void FBA_FObjectCache::SetPatchRevision(const FGuid& InstanceGuid, int32 PatchRevision)
+{
+	if (const int32* SlotPtr = GuidToSlot.Find(InstanceGuid))
+	{
+		Slots[*SlotPtr].PatchRevision = PatchRevision;
+	}
+}
+
+void FBA_FObjectCache::Invalidate(const FGuid& InstanceGuid)
+{
+	if (const int32* SlotPtr = GuidToSlot.Find(InstanceGuid))
+	{
+		RemoveSlot(*SlotPtr);
+	}
+}
+
+void FBA_FObjectCache::InvalidateOutdated(const FGuid& InstanceGuid, int32 PayloadRevision)
+{
+	if (const int32* SlotPtr = GuidToSlot.Find(InstanceGuid);
+		SlotPtr && Slots[*SlotPtr].PayloadRevision != PayloadRevision)
+	{
+		RemoveSlot(*SlotPtr);
+	}
+}
+
+void FBA_FObjectCache::Clear()
+{
+	Slots.Empty();
+	GuidToSlot.Empty();
+	FreeSlots.Empty();
+	Newest = INDEX_NONE;
+	Oldest = INDEX_NONE;
+}
+
+#pragma endregion
+
+#pragma region Usage List
+
+void FBA_FObjectCache::Unlink(int32 Slot)
+{
+	FBA_FCachedObject& CachedObject = Slots[Slot];
+	if (CachedObject.Newer != INDEX_NONE)
+	{
+		Slots[CachedObject.Newer].Older = CachedObject.Older;
+	}
+	else
+	{
+		Newest = CachedObject.Older;
+	}
+	if (CachedObject.Older != INDEX_NONE)
+	{
+		Slots[CachedObject.Older].Newer = CachedObject.Newer;
+	}
+	else
+	{
+		Oldest = CachedObject.Newer;
+	}
+	CachedObject.Newer = INDEX_NONE;
+	CachedObject.Older = INDEX_NONE;
+}
+
+void FBA_FObjectCache::LinkAsNewest(int32 Slot)
+{
+	Slots[Slot].Newer = INDEX_NONE;
+	Slots[Slot].Older = Newest;
+	if (Newest != INDEX_NONE)
+	{
+		Slots[Newest].Newer = Slot;
+	}
+	Newest = Slot;
+	if (Oldest == INDEX_NONE)
+	{
+		Oldest = Slot;
+	}
+}
+
+void FBA_FObjectCache::RemoveSlot(int32 Slot)
+{
+	if (!Slots.IsValidIndex(Slot))
+	{
+		return;
+	}
+	Unlink(Slot);
+	GuidToSlot.Remove(Slots[Slot].InstanceGuid);
+	// the object is released to the garbage collector
+	Slots[Slot].Object = nullptr;
+	Slots[Slot].InstanceGuid.Invalidate();
+	FreeSlots.Add(Slot);
+}
+
+#pragma endregion
@@ -0,0 +1,239 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "BA_FOrderStatistics.h"
+
+void FBA_FOrderStatistics::Add(double Value)
+{
+	Root = Insert(Root, Value);
+}
+
+bool FBA_FOrderStatistics::Remove(double Value)
+{
+	bool bRemoved = false;
+	Root = Erase(Root, Value, bRemoved);
+	return bRemoved;
+}
+
+void FBA_FOrderStatistics::Reset()
+{
+	Nodes.Reset();
+	FreeNodes.Reset();
+	Root = INDEX_NONE;
+}
+
+bool FBA_FOrderStatistics::GetMin(double& OutValue) const
+{
+	if (Root == INDEX_NONE)
+	{
+		return false;
+	}
+	int32 NodeIndex = Root;
+	while (Nodes[NodeIndex].Left != INDEX_NONE)
+	{
+		NodeIndex = Nodes[NodeIndex].Left;
+	}
+	OutValue = Nodes[NodeIndex].Value;
+	return true;
+}
+
+bool FBA_FOrderStatistics::GetMax(double& OutValue) const
+{
+	if (Root == INDEX_NONE)
+	{
+		return false;
+	}
+	int32 NodeIndex = Root;
+	while (Nodes[NodeIndex].Right != INDEX_NONE)
+	{
+		NodeIndex = Nodes[NodeIndex].Right;
+	}
+	OutValue = Nodes[NodeIndex].Value;
+	return true;
+}
+
+bool FBA_FOrderStatistics::GetKthSmallest(int64 K, double& OutValue) const
+{
+	if (K < 0 || K >= Num())
+	{
+		return false;
+	}
+	int32 NodeIndex = Root;
+	while (NodeIndex != INDEX_NONE)
+	{
+		const FNode& Node = Nodes[NodeIndex];
+		const int64 LeftSize = Node.Left != INDEX_NONE ? Nodes[Node.Left].Size : 0;
+		if (K < LeftSize)
+		{
+			NodeIndex = Node.Left;
+		}
+		else if (K < LeftSize + Node.Count)
+		{
+			OutValue = Node.Value;
+			return true;
+		}
+		else
+		{
+			K -= LeftSize + Node.Count;
+			NodeIndex = Node.Right;
+		}
+	}
+	return false;
+}
+
+bool FBA_FOrderStatistics::GetMedian(double& OutValue) const
+{
+	const int64 Count = Num();
+	if (Count == 0)
+	{
+		return false;
+	}
+	double Lower, Upper;
+	GetKthSmallest((Count - 1) / 2, Lower);
+	GetKthSmallest(Count / 2, Upper);
+	OutValue = (Lower + Upper) / 2;
+	return true;
+}
+
+void FBA_FOrderStatistics::ForEachValue(TFunctionRef<void(double Value, int64 Count)> Func) const
+{
+	// in-order traversal without recursion, the treap depth is only expected to be logarithmic
+	TArray<int32, TInlineAllocator<64>> Stack;
+	int32 NodeIndex = Root;
+	while (NodeIndex != INDEX_NONE || !Stack.IsEmpty())
+	{
+		while (NodeIndex != INDEX_NONE)
+		{
+			Stack.Push(NodeIndex);
+			NodeIndex = Nodes[NodeIndex].Left;
+		}
+		NodeIndex = Stack.Pop(EAllowShrinking::No);
+		Func(Nodes[NodeIndex].Value, Nodes[NodeIndex].Count);
+		NodeIndex = Nodes[NodeIndex].Right;
+	}
+}
+
+int32 FBA_FOrderStatistics::Insert(int32 NodeIndex, double Value)
+{
+	if (NodeIndex == INDEX_NONE)
+	{
+		return NewNode(Value);
+	}
+	if (Value == Nodes[NodeIndex].Value)
+	{
+		Nodes[NodeIndex].Count++;
+	}
+	else if (Value < Nodes[NodeIndex].Value)
+	{
+		const int32 Left = Insert(Nodes[NodeIndex].Left, Value);
+		Nodes[NodeIndex].Left = Left;
+		if (Nodes[Left].Priority > Nodes[NodeIndex].Priority)
+		{
+			NodeIndex = RotateRight(NodeIndex);
+		}
+	}
+	else
+	{
+		const int32 Right = Insert(Nodes[NodeIndex].Right, Value);
+		Nodes[NodeIndex].Right = Right;
+		if (Nodes[Right].Priority > Nodes[NodeIndex].Priority)
+		{
+			NodeIndex = RotateLeft(NodeIndex);
+		}
+	}
+	UpdateSize(NodeIndex);
+	return NodeIndex;
+}
+
+int32 FBA_FOrderStatistics::Erase(int32 NodeIndex, double Value, bool& bOutRemoved)
+{
+	if (NodeIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+	FNode& Node = Nodes[NodeIndex];
+	if (Value < Node.Value)
+	{
+		Node.Left = Erase(Node.Left, Value, bOutRemoved);
+	}
+	else if (Value > Node.Value)
+	{
+		Node.Right = Erase(Node.Right, Value, bOutRemoved);
+	}
+	else if (Node.Count > 1)
+	{
+		Node.Count--;
+		bOutRemoved = true;
+	}
+	else if (Node.Left == INDEX_NONE || Node.Right == INDEX_NONE)
+	{
+		const int32 Child = Node.Left != INDEX_NONE ? Node.Left : Node.Right;
+		FreeNode(NodeIndex);
+		bOutRemoved = true;
+		return Child;
+	}
+	else
+	{
+		// rotate the node down below its higher priority child until it has at most one child
+		if (Nodes[Node.Left].Priority > Nodes[Node.Right].Priority)
+		{
+			NodeIndex = RotateRight(NodeIndex);
+			Nodes[NodeIndex].Right = Erase(Nodes[NodeIndex].Right, Value, bOutRemoved);
+		}
+		else
+		{
+			NodeIndex = RotateLeft(NodeIndex);
+			Nodes[NodeIndex].Left = Erase(Nodes[NodeIndex].Left, Value, bOutRemoved);
+		}
+	}
+	UpdateSize(NodeIndex);
+	return NodeIndex;
+}
+
+int32 FBA_FOrderStatistics::RotateLeft(int32 NodeIndex)
+{
+	const int32 Pivot = Nodes[NodeIndex].Right;
+	Nodes[NodeIndex].Right = Nodes[Pivot].Left;
+	Nodes[Pivot].Left = NodeIndex;
+	UpdateSize(NodeIndex);
+	UpdateSize(Pivot);
+	return Pivot;
+}
+
+int32 FBA_FOrderStatistics::RotateRight(int32 NodeIndex)
+{
+	const int32 Pivot = Nodes[NodeIndex].Left;
+	Nodes[NodeIndex].Left = Nodes[Pivot].Right;
+	Nodes[Pivot].Right = NodeIndex;
+	UpdateSize(NodeIndex);
+	UpdateSize(Pivot);
+	return Pivot;
+}
+
+void FBA_FOrderStatistics::UpdateSize(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	Node.Size = Node.Count
+		+ (Node.Left != INDEX_NONE ? Nodes[Node.Left].Size : 0)
+		+ (Node.Right != INDEX_NONE ? Nodes[Node.Right].Size : 0);
+}
+
+int32 FBA_FOrderStatistics::NewNode(double Value)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+
+	const int32 NodeIndex = FreeNodes.IsEmpty() ? Nodes.AddDefaulted() : FreeNodes.Pop(EAllowShrinking::No);
+	FNode& Node = Nodes[NodeIndex];
+	Node = FNode();
+	Node.Value = Value;
+	Node.Count = 1;
+	Node.Size = 1;
+	Node.Priority = Seed;
+	return NodeIndex;
+}
+
+void FBA_FOrderStatistics::FreeNode(int32 NodeIndex)
+{
+	FreeNodes.Add(NodeIndex);
+}
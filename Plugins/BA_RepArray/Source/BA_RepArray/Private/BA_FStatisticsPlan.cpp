@@ -0,0 +1,46 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "BA_FStatisticsPlan.h"
+#include "Logging/StructuredLog.h"
+#include "BA_RepArray.h"
+
+void FBA_FStatisticsPlan::Compile(const UStruct* Type, TFunctionRef<int32(const FProperty*)> FindOrAddStatistics)
+{
+	Steps.Reset();
+	if (!Type)
+	{
+		return;
+	}
+	for (TFieldIterator<FNumericProperty> PropIt(Type); PropIt; ++PropIt)
+	{
+		FStep Step;
+		Step.Property = *PropIt;
+		Step.Offset = PropIt->GetOffset_ForInternal();
+		Step.StatPosition = FindOrAddStatistics(*PropIt);
+		if (Step.StatPosition != INDEX_NONE && GetValueKind(*PropIt, Step.Kind))
+		{
+			Steps.Add(Step);
+		}
+	}
+	UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Statistics plan of '{type}' compiled with {count} properties"
+		, __FUNCTION__, Type->GetName(), Steps.Num());
+}
+
+bool FBA_FStatisticsPlan::GetValueKind(const FNumericProperty* Property, EValueKind& OutKind)
+{
+	if (Property->IsA<FInt8Property>())			{ OutKind = EValueKind::Int8; }
+	else if (Property->IsA<FInt16Property>())	{ OutKind = EValueKind::Int16; }
+	else if (Property->IsA<FIntProperty>())		{ OutKind = EValueKind::Int32; }
+	else if (Property->IsA<FInt64Property>())	{ OutKind = EValueKind::Int64; }
+	else if (Property->IsA<FByteProperty>())	{ OutKind = EValueKind::UInt8; }
+	else if (Property->IsA<FUInt16Property>())	{ OutKind = EValueKind::UInt16; }
+	else if (Property->IsA<FUInt32Property>())	{ OutKind = EValueKind::UInt32; }
+	else if (Property->IsA<FUInt64Property>())	{ OutKind = EValueKind::UInt64; }
+	else if (Property->IsA<FFloatProperty>())	{ OutKind = EValueKind::Float; }
+	else if (Property->IsA<FDoubleProperty>())	{ OutKind = EValueKind::Double; }
+	else
+	{
+		return false;
+	}
+	return true;
+}
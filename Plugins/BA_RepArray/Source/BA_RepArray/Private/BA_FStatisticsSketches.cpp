@@ -0,0 +1,202 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "BA_FStatisticsSketches.h"
+#include "Algo/Sort.h"
+
+#pragma region FBA_FQuantileSketch
+
+void FBA_FQuantileSketch::Add(double Value)
+{
+	if (LevelSizes.IsEmpty())
+	{
+		LevelSizes.Add(0);
+	}
+	Items.Add(static_cast<float>(Value));
+	LevelSizes[0]++;
+	Count++;
+	CompressIfNeeded();
+}
+
+void FBA_FQuantileSketch::Merge(const FBA_FQuantileSketch& Other)
+{
+	K = FMath::Min(K, Other.K);
+	for (int32 Level = 0; Level < Other.LevelSizes.Num(); Level++)
+	{
+		if (Level >= LevelSizes.Num())
+		{
+			// new top level in front
+			LevelSizes.Add(0);
+		}
+		const int32 OtherOffset = Other.LevelOffset(Level);
+		// append behind the values of the same level
+		Items.Insert(Other.Items.GetData() + OtherOffset, Other.LevelSizes[Level], LevelOffset(Level) + LevelSizes[Level]);
+		LevelSizes[Level] += Other.LevelSizes[Level];
+	}
+	Count += Other.Count;
+	CompressIfNeeded();
+}
+
+void FBA_FQuantileSketch::Reset()
+{
+	Count = 0;
+	Items.Reset();
+	LevelSizes.Reset();
+}
+
+bool FBA_FQuantileSketch::GetQuantile(double Fraction, double& OutValue) const
+{
+	if (Items.IsEmpty())
+	{
+		return false;
+	}
+	// every value of level h stands for 2^h values
+	TArray<TPair<float, int64>> Weighted;
+	Weighted.Reserve(Items.Num());
+	int64 TotalWeight = 0;
+	for (int32 Level = 0; Level < LevelSizes.Num(); Level++)
+	{
+		const int64 Weight = int64(1) << Level;
+		const int32 Offset = LevelOffset(Level);
+		for (int32 Index = Offset; Index < Offset + LevelSizes[Level]; Index++)
+		{
+			Weighted.Emplace(Items[Index], Weight);
+		}
+		TotalWeight += Weight * LevelSizes[Level];
+	}
+	Weighted.Sort([](const TPair<float, int64>& A, const TPair<float, int64>& B) { return A.Key < B.Key; });
+
+	const double Target = FMath::Clamp(Fraction, 0.0, 1.0) * TotalWeight;
+	int64 Cumulative = 0;
+	for (const TPair<float, int64>& Item : Weighted)
+	{
+		Cumulative += Item.Value;
+		if (Cumulative >= Target)
+		{
+			OutValue = Item.Key;
+			return true;
+		}
+	}
+	OutValue = Weighted.Last().Key;
+	return true;
+}
+
+int32 FBA_FQuantileSketch::Capacity(int32 Level) const
+{
+	// capacities shrink by 2/3 per level below the top
+	const int32 Depth = LevelSizes.Num() - 1 - Level;
+	return FMath::Max(2, FMath::CeilToInt32(K * FMath::Pow(2.0 / 3.0, Depth)));
+}
+
+int32 FBA_FQuantileSketch::LevelOffset(int32 Level) const
+{
+	int32 Offset = 0;
+	for (int32 Higher = LevelSizes.Num() - 1; Higher > Level; Higher--)
+	{
+		Offset += LevelSizes[Higher];
+	}
+	return Offset;
+}
+
+void FBA_FQuantileSketch::CompressIfNeeded()
+{
+	while (true)
+	{
+		// capacities depend on the number of levels, so recompute after every compaction
+		int32 TotalCapacity = 0;
+		int32 FullLevel = INDEX_NONE;
+		for (int32 Level = 0; Level < LevelSizes.Num(); Level++)
+		{
+			const int32 LevelCapacity = Capacity(Level);
+			TotalCapacity += LevelCapacity;
+			if (FullLevel == INDEX_NONE && LevelSizes[Level] >= LevelCapacity)
+			{
+				FullLevel = Level;
+			}
+		}
+		if (Items.Num() <= TotalCapacity || FullLevel == INDEX_NONE)
+		{
+			return;
+		}
+		CompressLevel(FullLevel);
+	}
+}
+
+void FBA_FQuantileSketch::CompressLevel(int32 Level)
+{
+	if (Level + 1 >= LevelSizes.Num())
+	{
+		LevelSizes.Add(0);
+	}
+	const int32 Offset = LevelOffset(Level);
+	const int32 Size = LevelSizes[Level];
+	float* LevelItems = Items.GetData() + Offset;
+	Algo::Sort(MakeArrayView(LevelItems, Size));
+
+	// keep every other value, the odd one out stays on this level
+	const int32 Pairs = Size / 2;
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	const int32 Start = Seed & 1;
+	const bool bOdd = Size % 2 == 1;
+	const float Leftover = bOdd ? LevelItems[Size - 1] : 0;
+	for (int32 Pair = 0; Pair < Pairs; Pair++)
+	{
+		LevelItems[Pair] = LevelItems[Pair * 2 + Start];
+	}
+	// the survivors are now directly behind the next level
+	LevelSizes[Level + 1] += Pairs;
+	int32 Remaining = 0;
+	if (bOdd)
+	{
+		LevelItems[Pairs] = Leftover;
+		Remaining = 1;
+	}
+	Items.RemoveAt(Offset + Pairs + Remaining, Size - Pairs - Remaining, EAllowShrinking::No);
+	LevelSizes[Level] = Remaining;
+}
+
+#pragma endregion
+
+#pragma region FBA_FHistogram
+
+void FBA_FHistogram::Reset(int32 NumBins, double InRangeMin, double InRangeMax)
+{
+	RangeMin = InRangeMin;
+	RangeMax = FMath::Max(InRangeMin, InRangeMax);
+	Bins.Reset();
+	Bins.SetNumZeroed(FMath::Max(NumBins, 1));
+}
+
+bool FBA_FHistogram::Add(double Value)
+{
+	if (Bins.IsEmpty())
+	{
+		return false;
+	}
+	Bins[GetBin(Value)]++;
+	return Value >= RangeMin && Value <= RangeMax;
+}
+
+void FBA_FHistogram::Remove(double Value)
+{
+	if (Bins.IsEmpty())
+	{
+		return;
+	}
+	int32& Bin = Bins[GetBin(Value)];
+	Bin = FMath::Max(Bin - 1, 0);
+}
+
+int32 FBA_FHistogram::GetBin(double Value) const
+{
+	const double Width = RangeMax - RangeMin;
+	if (Width <= 0)
+	{
+		return 0;
+	}
+	// RangeMax belongs to the last bin
+	return FMath::Clamp(FMath::FloorToInt32((Value - RangeMin) / Width * Bins.Num()), 0, Bins.Num() - 1);
+}
+
+#pragma endregion
@@ -6,10 +6,13 @@
 #include "UObject/UnrealTypePrivate.h"
 #include "Logging/StructuredLog.h"
 #include "Net/UnrealNetwork.h"
+#include "TimerManager.h"
 
 ABA_ReplicationInfo::ABA_ReplicationInfo()
 {
     ReplicatedObjectArray = FBA_FFA_ObjectArray(this);
+    ReplicatedObjectArray.SharedPayloadStore = &SharedPayloadStore;
+    ReplicatedObjectArray.ClassTable = &ClassTable;
 
     bReplicates = true;
     NetUpdateFrequency = 50.0f;
@@ -20,15 +23,57 @@ ABA_ReplicationInfo::ABA_ReplicationInfo()
     this->bReplicateUsingRegisteredSubObjectList = true;
     //ReplicatedObjectArray = CreateDefaultSubobject<FBA_FFA_ObjectArray>(FName(FGuid::NewGuid().ToString()));
     BindEvents();
-    if (this->HasAuthority())
+    RandomStream = FMath::Rand();
+}
+
+#pragma region Overrides
+
+void ABA_ReplicationInfo::PostInitProperties()
+{
+    Super::PostInitProperties();
+    // config values are available now
+    ReplicatedObjectArray.SharedPayloadStore = &SharedPayloadStore;
+    ReplicatedObjectArray.ClassTable = &ClassTable;
+    ReplicatedObjectArray.PayloadSettings.bSharePayloads = bSharePayloads;
+    ReplicatedObjectArray.PayloadSettings.Format = PayloadFormat;
+    ReplicatedObjectArray.PayloadSettings.CompressionCodec = PayloadCompressionCodec;
+    ReplicatedObjectArray.PayloadSettings.CompressionThreshold = PayloadCompressionThreshold;
+    ReplicatedObjectArray.PayloadSettings.PatchRebaseRatio = PropertyPatchRebaseRatio;
+    ReplicatedObjectArray.SetPropertyDeltaReplication(bPropertyDeltaReplication);
+    ObjectCache.SetCapacity(MaxCachedObjects);
+    ReplicatedObjectArray.SetNumericColumns(bNumericColumns);
+    for (const FName& PropertyName : IndexedProperties)
     {
-        // Load convenience names and adjectives to give better object names
-        LoadFileToArray("Adjectives.txt", Adjectives);
-        LoadFileToArray("Names.txt", Names);
+        ReplicatedObjectArray.CreatePropertyIndex(PropertyName);
     }
-    RandomStream = FMath::Rand();
+    for (const FName& PropertyName : RangeIndexedProperties)
+    {
+        ReplicatedObjectArray.CreateRangeIndex(PropertyName);
+    }
+#if WITH_RELOAD
+    // reloaded types can change their properties and offsets
+    if (!HasAnyFlags(RF_ClassDefaultObject))
+    {
+        FCoreUObjectDelegates::ReloadCompleteDelegate.AddWeakLambda(this, [this](EReloadCompleteReason)
+            {
+                StatisticsPlans.Empty();
+                ReplicatedObjectArray.ResetTypeCaches();
+                BA_Statics::ResetPropertyTables();
+            });
+    }
+#endif
+}
+
+void ABA_ReplicationInfo::BeginDestroy()
+{
+#if WITH_RELOAD
+    FCoreUObjectDelegates::ReloadCompleteDelegate.RemoveAll(this);
+#endif
+    Super::BeginDestroy();
 }
 
+#pragma endregion
+
 #pragma region Authority Only
 
 void ABA_ReplicationInfo::AddObject(UObject* StorageObject, bool& SuccessfullyAdded, FGuid& InstanceGuid, FString& InstanceIdentifier, const int64 NumberOfNewObjects)
@@ -41,26 +86,43 @@ void ABA_ReplicationInfo::AddObject(UObject* StorageObject, bool& SuccessfullyAd
         return;
     }
     
-    if (StorageObject)
+    // serialize once, all copies share the payload
+    FBA_FFA_Object Prototype;
+    if (StorageObject && ReplicatedObjectArray.PrepareEntry(StorageObject, Prototype))
     {
         int64 SuccessCounter = 0;
         
-        TMap<FString, FGuid> Identifiers;
+        TArray<TPair<FBA_FIdentifier, FGuid>> Identifiers;
+        TSet<FBA_FIdentifier> UsedIdentifiers;
         while (Identifiers.Num() < NumberOfNewObjects)
         {
-            Identifiers.Emplace(this->GetUniqueName(), FGuid::NewGuid());
+            // guid based identifiers (no dictionary loaded) are unique anyway
+            FBA_FIdentifier Identifier = GenerateIdentifier();
+            bool bAlreadyUsed = false;
+            if (!Identifier.IsGuidBased())
+            {
+                UsedIdentifiers.Add(Identifier, &bAlreadyUsed);
+            }
+            if (!bAlreadyUsed)
+            {
+                Identifiers.Emplace(Identifier, FGuid::NewGuid());
+            }
         }
+        FBA_FIdentifier LastIdentifier;
         for (auto& KvP : Identifiers)
         {
-            if (SuccessfullyAdded = ReplicatedObjectArray.AddEntry(StorageObject, KvP.Value, KvP.Key);
+            if (SuccessfullyAdded = ReplicatedObjectArray.AddPreparedEntry(Prototype, KvP.Value, KvP.Key);
                 SuccessfullyAdded == true)
             {
-                InstanceIdentifier = KvP.Key;
+                LastIdentifier = KvP.Key;
                 InstanceGuid = KvP.Value;
                 SuccessCounter++;
-                UpdateStatistics_Add(StorageObject);
+                UpdateStatistics_Add(KvP.Value, StorageObject);
             }
         }
+        ReplicatedObjectArray.ReleasePreparedEntry(Prototype);
+        // readable string only for the returned entry
+        InstanceIdentifier = SuccessCounter > 0 ? LastIdentifier.ToString(InstanceGuid) : FString();
         SuccessfullyAdded = SuccessCounter == NumberOfNewObjects;
     }
     else
@@ -70,22 +132,211 @@ void ABA_ReplicationInfo::AddObject(UObject* StorageObject, bool& SuccessfullyAd
     }
 }
 
+void ABA_ReplicationInfo::AddObjects(const TArray<UObject*>& StorageObjects, int32& NumberAdded, TArray<FGuid>& InstanceGuids)
+{
+    NumberAdded = 0;
+    InstanceGuids.Reset();
+    if (StorageObjects.IsEmpty())
+    {
+        return;
+    }
+
+    TArray<FBA_FIdentifier> Identifiers;
+    Identifiers.Reserve(StorageObjects.Num());
+    TSet<FBA_FIdentifier> UsedIdentifiers;
+    while (Identifiers.Num() < StorageObjects.Num())
+    {
+        // guid based identifiers (no dictionary loaded) are unique anyway
+        FBA_FIdentifier Identifier = GenerateIdentifier();
+        bool bAlreadyUsed = false;
+        if (!Identifier.IsGuidBased())
+        {
+            UsedIdentifiers.Add(Identifier, &bAlreadyUsed);
+        }
+        if (!bAlreadyUsed)
+        {
+            Identifiers.Add(Identifier);
+        }
+    }
+
+    NumberAdded = ReplicatedObjectArray.AddEntries(StorageObjects, Identifiers, InstanceGuids);
+    if (NumberAdded == 0)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: None of the {count} objects could be added"
+            , __FUNCTION__, StorageObjects.Num());
+        return;
+    }
+
+    // one statistics sweep for all added objects
+    TArray<UObject*> AddedObjects;
+    TArray<FGuid> AddedGuids;
+    AddedObjects.Reserve(NumberAdded);
+    AddedGuids.Reserve(NumberAdded);
+    for (int32 Index = 0; Index < StorageObjects.Num(); Index++)
+    {
+        if (InstanceGuids[Index].IsValid())
+        {
+            AddedObjects.Add(StorageObjects[Index]);
+            AddedGuids.Add(InstanceGuids[Index]);
+        }
+    }
+    UpdateStatistics_AddBatch(AddedObjects, AddedGuids);
+}
+
 void ABA_ReplicationInfo::ClearArray()
 {
     ReplicatedObjectArray.Clear();
+    ObjectCache.Clear();
     StatisticsArray.Empty();
+    EntryStatisticsValues.Empty();
+    // plans refer to positions in StatisticsArray
+    StatisticsPlans.Empty();
     OnFullArrayChangeEmpty.Broadcast();
 }
 
 bool ABA_ReplicationInfo::RemoveEntry(FGuid Guid, UObject*& DeletedEntry)
 {
-    if (ReplicatedObjectArray.RemoveEntry(Guid, DeletedEntry);
-        IsValid(DeletedEntry))
+    if (!ReplicatedObjectArray.RemoveEntry(Guid, DeletedEntry))
     {
-        UpdateStatistics_Remove(DeletedEntry);
-        return true;
+        return false;
     }
-    return false;
+    ObjectCache.Invalidate(Guid);
+    UpdateStatistics_Remove(Guid);
+    return true;
+}
+
+int32 ABA_ReplicationInfo::RemoveEntries(const TArray<FGuid>& Guids)
+{
+    TArray<FGuid> RemovedGuids;
+    const int32 NumberRemoved = ReplicatedObjectArray.RemoveEntries(Guids, RemovedGuids);
+    for (const FGuid& Guid : RemovedGuids)
+    {
+        ObjectCache.Invalidate(Guid);
+    }
+    UpdateStatistics_RemoveBatch(RemovedGuids);
+    return NumberRemoved;
+}
+
+bool ABA_ReplicationInfo::AddStructEntry(const UScriptStruct* StructType, const void* StructData, FGuid& InstanceGuid, FString& InstanceIdentifier)
+{
+    FBA_FFA_Object Prototype;
+    if (!ReplicatedObjectArray.PrepareStructEntry(StructType, StructData, Prototype))
+    {
+        return false;
+    }
+    InstanceGuid = FGuid::NewGuid();
+    const FBA_FIdentifier Identifier = GenerateIdentifier();
+    InstanceIdentifier = Identifier.ToString(InstanceGuid);
+    const bool bAdded = ReplicatedObjectArray.AddPreparedEntry(Prototype, InstanceGuid, Identifier);
+    ReplicatedObjectArray.ReleasePreparedEntry(Prototype);
+    if (bAdded)
+    {
+        UpdateStatistics_Add(InstanceGuid, StructType, StructData);
+    }
+    return bAdded;
+}
+
+DEFINE_FUNCTION(ABA_ReplicationInfo::execAddStruct)
+{
+    // wildcard struct parameter, type and address are taken from the connected pin
+    Stack.MostRecentProperty = nullptr;
+    Stack.MostRecentPropertyAddress = nullptr;
+    Stack.StepCompiledIn<FStructProperty>(nullptr);
+    const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+    const void* StructData = Stack.MostRecentPropertyAddress;
+    P_GET_UBOOL_REF(SuccessfullyAdded);
+    P_GET_STRUCT_REF(FGuid, InstanceGuid);
+    P_GET_PROPERTY_REF(FStrProperty, InstanceIdentifier);
+    P_FINISH;
+
+    P_NATIVE_BEGIN;
+    SuccessfullyAdded = StructProperty && StructData
+        && P_THIS->AddStructEntry(StructProperty->Struct, StructData, InstanceGuid, InstanceIdentifier);
+    P_NATIVE_END;
+}
+
+void ABA_ReplicationInfo::UpdateEntryProperties(FGuid Guid, UObject* ModifiedObject, bool& Updated, TArray<FName>& ChangedProperties)
+{
+    Updated = false;
+    FBA_FFA_Object Entry;
+    if (!IsValid(ModifiedObject) || !ReplicatedObjectArray.GetEntryByGuid(Guid, Entry))
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Guid '{guid}' not found or object provided is not valid"
+            , __FUNCTION__, Guid.ToString());
+        return;
+    }
+    if (Updated = ReplicatedObjectArray.UpdateEntryProperties(Guid, ModifiedObject, ChangedProperties);
+        Updated)
+    {
+        // the cached object only stays valid if just the property patch changed
+        if (ReplicatedObjectArray.GetEntryByGuid(Guid, Entry))
+        {
+            ObjectCache.InvalidateOutdated(Guid, Entry.PayloadRevision);
+        }
+        UpdateStatistics_Change(Guid, ModifiedObject->GetClass(), ModifiedObject);
+    }
+}
+
+bool ABA_ReplicationInfo::UpdateEntry(FGuid Guid, UObject* ModifiedObject)
+{
+    bool Updated = false;
+    TArray<FName> ChangedProperties;
+    UpdateEntryProperties(Guid, ModifiedObject, Updated, ChangedProperties);
+    return Updated;
+}
+
+bool ABA_ReplicationInfo::SetEntryPropertyValue(FGuid Guid, FName PropertyName, const FProperty* ValueProperty, const void* Value)
+{
+    const FProperty* EntryProperty = nullptr;
+    if (!ReplicatedObjectArray.SetEntryProperty(Guid, PropertyName, ValueProperty, Value, EntryProperty))
+    {
+        return false;
+    }
+    if (FBA_FFA_Object Entry;
+        ReplicatedObjectArray.GetEntryByGuid(Guid, Entry))
+    {
+        ObjectCache.InvalidateOutdated(Guid, Entry.PayloadRevision);
+    }
+    // Value is no container of the entry type, it is read directly
+    TOptional<double> NewValue;
+    if (double PropertyValue;
+        GetStatisticsValueFromPtr(ValueProperty, Value, PropertyValue))
+    {
+        NewValue = PropertyValue;
+    }
+    UpdateStatistics_Change(Guid, EntryProperty, NewValue);
+    return true;
+}
+
+DEFINE_FUNCTION(ABA_ReplicationInfo::execSetEntryProperty)
+{
+    P_GET_STRUCT(FGuid, Guid);
+    P_GET_PROPERTY(FNameProperty, PropertyName);
+    // wildcard value parameter, type and address are taken from the connected pin
+    Stack.MostRecentProperty = nullptr;
+    Stack.MostRecentPropertyAddress = nullptr;
+    Stack.StepCompiledIn<FProperty>(nullptr);
+    const FProperty* ValueProperty = Stack.MostRecentProperty;
+    const void* Value = Stack.MostRecentPropertyAddress;
+    P_GET_UBOOL_REF(Updated);
+    P_FINISH;
+
+    P_NATIVE_BEGIN;
+    Updated = ValueProperty && Value
+        && P_THIS->SetEntryPropertyValue(Guid, PropertyName, ValueProperty, Value);
+    P_NATIVE_END;
+}
+
+int32 ABA_ReplicationInfo::SetPayloadFormat(EBA_EPayloadFormat NewPayloadFormat)
+{
+    if (NewPayloadFormat == EBA_EPayloadFormat::E_UNDEFINED)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Payload format UNDEFINED cannot be used"
+            , __FUNCTION__);
+        return 0;
+    }
+    PayloadFormat = NewPayloadFormat;
+    return ReplicatedObjectArray.MigratePayloadFormat(NewPayloadFormat);
 }
 
 #pragma endregion
@@ -101,7 +352,7 @@ TMap<FGuid, UObject*> ABA_ReplicationInfo::GetArrayObjects()
     TMap<FGuid, UObject*> Results;
     ReplicatedObjectArray.ForEachChildren([&Results, this](FBA_FFA_Object Entry)
         {
-            if (UObject* Object = BA_Statics::DeserializeObjectFromString(Entry.SerializedObject, this, Entry.ClassToCastTo);
+            if (UObject* Object = GetCachedEntryObject(Entry);
                 Object)
             {
                 Results.Emplace(Entry.InstanceGuid, Object);
@@ -112,6 +363,41 @@ TMap<FGuid, UObject*> ABA_ReplicationInfo::GetArrayObjects()
     return Results;
 }
 
+TMap<FGuid, UObject*> ABA_ReplicationInfo::GetArrayObjectsOfClass(UClass* Class)
+{
+    TMap<FGuid, UObject*> Results;
+    const int32 ClassIndex = ClassTable.GetTypes().IndexOfByKey(Class);
+    if (!Class || ClassIndex == INDEX_NONE)
+    {
+        return Results;
+    }
+    for (const FBA_FFA_Object& Entry : ReplicatedObjectArray.Items)
+    {
+        if (Entry.GetClassIndex() != ClassIndex)
+        {
+            continue;
+        }
+        if (UObject* Object = GetCachedEntryObject(Entry))
+        {
+            Results.Emplace(Entry.InstanceGuid, Object);
+        }
+    }
+    return Results;
+}
+
+TArray<UClass*> ABA_ReplicationInfo::GetEntryClasses() const
+{
+    TArray<UClass*> Classes;
+    for (UStruct* Type : ClassTable.GetTypes())
+    {
+        if (UClass* Class = Cast<UClass>(Type))
+        {
+            Classes.Add(Class);
+        }
+    }
+    return Classes;
+}
+
 void ABA_ReplicationInfo::GetObjectByGuid(FGuid Guid, bool& Found, UObject*& ObjectFound, FString& InstanceIdentifier)
 {
     Found = false;
@@ -122,13 +408,10 @@ void ABA_ReplicationInfo::GetObjectByGuid(FGuid Guid, bool& Found, UObject*& Obj
         Found = false;
         return;
     }
-    if (ObjectFound = BA_Statics::DeserializeObjectFromString(
-        Entry.SerializedObject,
-        this,
-        Entry.ClassToCastTo);
+    if (ObjectFound = GetCachedEntryObject(Entry);
         ObjectFound)
     {
-        InstanceIdentifier = Entry.InstanceIdentifier;
+        InstanceIdentifier = Entry.GetReadableIdentifier();
         Found = true;
     }
 }
@@ -142,12 +425,43 @@ void ABA_ReplicationInfo::GetObjectByIdentifier(FString Identifier, bool& Found,
         Found = false;
         return;
     }
-    if (ObjectFound = BA_Statics::DeserializeObjectFromString(
-        Entry.SerializedObject,
-        this,
-        Entry.ClassToCastTo);
+    if (ObjectFound = GetCachedEntryObject(Entry);
+        ObjectFound)
+    {
+        Found = true;
+    }
+}
+
+void ABA_ReplicationInfo::GetEntryIdentifier(FGuid Guid, bool& Found, FString& InstanceIdentifier)
+{
+    const FBA_FFA_Object* Entry = ReplicatedObjectArray.FindEntry(ReplicatedObjectArray.GetEntryHandle(Guid));
+    Found = Entry != nullptr;
+    InstanceIdentifier = Entry ? Entry->GetReadableIdentifier() : FString();
+}
+
+FString ABA_ReplicationInfo::GetReadableIdentifier(const FBA_FFA_Object& Entry)
+{
+    return Entry.GetReadableIdentifier();
+}
+
+void ABA_ReplicationInfo::GetEntryHandle(FGuid Guid, bool& Found, FBA_FEntryHandle& Handle)
+{
+    Handle = ReplicatedObjectArray.GetEntryHandle(Guid);
+    Found = ReplicatedObjectArray.FindEntry(Handle) != nullptr;
+}
+
+void ABA_ReplicationInfo::GetObjectByHandle(FBA_FEntryHandle Handle, bool& Found, UObject*& ObjectFound, FGuid& InstanceGuid)
+{
+    Found = false;
+    const FBA_FFA_Object* Entry = ReplicatedObjectArray.FindEntry(Handle);
+    if (!Entry)
+    {
+        return;
+    }
+    if (ObjectFound = GetCachedEntryObject(*Entry);
         ObjectFound)
     {
+        InstanceGuid = Entry->InstanceGuid;
         Found = true;
     }
 }
@@ -161,14 +475,11 @@ void ABA_ReplicationInfo::GetRandomEntry(bool& Found, UObject*& ObjectFound, FGu
     }
     int32 RandomEntryNumber = RandomStream.RandRange(0, (ReplicatedObjectArray.Items.Num() - 1));
     
-    if (ObjectFound = BA_Statics::DeserializeObjectFromString(
-        ReplicatedObjectArray.Items[RandomEntryNumber].SerializedObject,
-        this,
-        ReplicatedObjectArray.Items[RandomEntryNumber].ClassToCastTo);
+    if (ObjectFound = GetCachedEntryObject(ReplicatedObjectArray.Items[RandomEntryNumber]);
         ObjectFound)
     {
         InstanceGuid = ReplicatedObjectArray.Items[RandomEntryNumber].InstanceGuid;
-        InstanceIdentifier = ReplicatedObjectArray.Items[RandomEntryNumber].InstanceIdentifier;
+        InstanceIdentifier = ReplicatedObjectArray.Items[RandomEntryNumber].GetReadableIdentifier();
         if (InstanceGuid.IsValid())
         {
             Found = true;
@@ -176,6 +487,53 @@ void ABA_ReplicationInfo::GetRandomEntry(bool& Found, UObject*& ObjectFound, FGu
     }
 }
 
+void ABA_ReplicationInfo::RefreshObjectFromEntry(FGuid Guid, UObject* Object, int32 KnownPayloadRevision, int32 KnownPatchRevision, bool& Refreshed, int32& PayloadRevision, int32& PatchRevision)
+{
+    Refreshed = false;
+    FBA_FFA_Object Entry;
+    if (!IsValid(Object) || !ReplicatedObjectArray.GetEntryByGuid(Guid, Entry))
+    {
+        return;
+    }
+    Refreshed = ReplicatedObjectArray.RefreshObject(Entry, Object, KnownPayloadRevision, KnownPatchRevision);
+    PayloadRevision = Entry.PayloadRevision;
+    PatchRevision = Entry.GetPatchRevision();
+}
+
+bool ABA_ReplicationInfo::GetStructEntry(FGuid Guid, const UScriptStruct* StructType, void* OutStructData)
+{
+    FBA_FFA_Object Entry;
+    if (!ReplicatedObjectArray.GetEntryByGuid(Guid, Entry))
+    {
+        return false;
+    }
+    if (!Entry.IsStructEntry() || ReplicatedObjectArray.GetEntryStruct(Entry) != StructType)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Entry '{guid}' is no struct entry of type '{struct}'"
+            , __FUNCTION__, Guid.ToString(), StructType ? StructType->GetName() : FString("None"));
+        return false;
+    }
+    return ReplicatedObjectArray.CopyStructEntry(Entry, StructType, OutStructData);
+}
+
+DEFINE_FUNCTION(ABA_ReplicationInfo::execGetStructByGuid)
+{
+    P_GET_STRUCT(FGuid, Guid);
+    P_GET_UBOOL_REF(Found);
+    // wildcard struct parameter, type and address are taken from the connected pin
+    Stack.MostRecentProperty = nullptr;
+    Stack.MostRecentPropertyAddress = nullptr;
+    Stack.StepCompiledIn<FStructProperty>(nullptr);
+    const FStructProperty* StructProperty = CastField<FStructProperty>(Stack.MostRecentProperty);
+    void* StructData = Stack.MostRecentPropertyAddress;
+    P_FINISH;
+
+    P_NATIVE_BEGIN;
+    Found = StructProperty && StructData
+        && P_THIS->GetStructEntry(Guid, StructProperty->Struct, StructData);
+    P_NATIVE_END;
+}
+
 void ABA_ReplicationInfo::GetEntryObject(FGuid Guid, bool& ValidObjectFound, UObject*& ObjectFound, FGuid& InstanceGuid, FString& InstanceIdentifier)
 {
     ValidObjectFound = false;
@@ -186,24 +544,14 @@ void ABA_ReplicationInfo::GetEntryObject(FGuid Guid, bool& ValidObjectFound, UOb
         return;
     }
     
-    if (int32* Position = ReplicatedObjectArray.GuidToArrayPos.Find(Guid);
-        Position && *Position != INDEX_NONE)
+    if (const int32 Position = ReplicatedObjectArray.FindPosition(Guid);
+        Position != INDEX_NONE)
     {
-        if (!ReplicatedObjectArray.Items.IsValidIndex(*Position))
-        {
-            UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Detected mismatch between array and position map - position {pos} is not valid!"
-                , __FUNCTION__, FString::FromInt(*Position));
-            return;
-        }
-
-        if (ObjectFound = BA_Statics::DeserializeObjectFromString(
-            ReplicatedObjectArray.Items[*Position].SerializedObject,
-            this,
-            ReplicatedObjectArray.Items[*Position].ClassToCastTo);
+        if (ObjectFound = GetCachedEntryObject(ReplicatedObjectArray.Items[Position]);
             ObjectFound)
         {
-            InstanceGuid = ReplicatedObjectArray.Items[*Position].InstanceGuid;
-            InstanceIdentifier = ReplicatedObjectArray.Items[*Position].InstanceIdentifier;
+            InstanceGuid = ReplicatedObjectArray.Items[Position].InstanceGuid;
+            InstanceIdentifier = ReplicatedObjectArray.Items[Position].GetReadableIdentifier();
             ValidObjectFound = true;
         }
     }
@@ -246,12 +594,293 @@ void ABA_ReplicationInfo::SortByObjectPropertyName(FString PropertyName)
     OnFullArrayChangeSort.Broadcast();
 }
 
+bool ABA_ReplicationInfo::CreateSortedView(FName ViewName, FString PropertyName, bool bDescending)
+{
+    const FName SortPropertyName = PropertyName.IsEmpty() ? NAME_None : FName(*PropertyName);
+    return ReplicatedObjectArray.CreateSortedView(ViewName, SortPropertyName, bDescending, SortableTypesArray);
+}
+
+bool ABA_ReplicationInfo::RemoveSortedView(FName ViewName)
+{
+    return ReplicatedObjectArray.RemoveSortedView(ViewName);
+}
+
+void ABA_ReplicationInfo::GetSortedView(FName ViewName, bool& Found, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids)
+{
+    Objects.Reset();
+    InstanceGuids.Reset();
+    const FBA_FSortedView* View = ReplicatedObjectArray.FindSortedView(ViewName);
+    Found = View != nullptr;
+    if (!View)
+    {
+        return;
+    }
+    GetObjectsOfHandles(View->GetHandles(), Objects, InstanceGuids);
+}
+
+bool ABA_ReplicationInfo::AddPropertyIndex(FName PropertyName)
+{
+    return ReplicatedObjectArray.CreatePropertyIndex(PropertyName);
+}
+
+bool ABA_ReplicationInfo::RemovePropertyIndex(FName PropertyName)
+{
+    return ReplicatedObjectArray.RemovePropertyIndex(PropertyName);
+}
+
+void ABA_ReplicationInfo::FindEntriesByValue(FName PropertyName, FString Value, bool& IndexFound, TArray<FGuid>& InstanceGuids)
+{
+    InstanceGuids.Reset();
+    const FBA_FPropertyIndex* Index = ReplicatedObjectArray.FindPropertyIndex(PropertyName);
+    IndexFound = Index != nullptr;
+    if (!Index)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Property '{property}' is not indexed"
+            , __FUNCTION__, PropertyName);
+        return;
+    }
+    // the text does not tell the property type, so it is looked up as string and, if possible, as number
+    TArray<FBA_FSortKey, TInlineAllocator<2>> Keys;
+    Keys.Add(FBA_FSortKey::FromString(Value));
+    if (Value.IsNumeric())
+    {
+        Keys.Add(FBA_FSortKey::FromNumber(FCString::Atod(*Value)));
+    }
+    else if (Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("false"), ESearchCase::IgnoreCase))
+    {
+        Keys.Add(FBA_FSortKey::FromNumber(Value.ToBool() ? 1 : 0));
+    }
+    for (const FBA_FSortKey& Key : Keys)
+    {
+        const TSet<FBA_FEntryHandle>* Handles = Index->Find(Key);
+        if (!Handles)
+        {
+            continue;
+        }
+        InstanceGuids.Reserve(InstanceGuids.Num() + Handles->Num());
+        for (const FBA_FEntryHandle& Handle : *Handles)
+        {
+            if (const FBA_FFA_Object* Entry = ReplicatedObjectArray.FindEntry(Handle))
+            {
+                InstanceGuids.Add(Entry->InstanceGuid);
+            }
+        }
+    }
+}
+
+bool ABA_ReplicationInfo::AddRangeIndex(FName PropertyName)
+{
+    return ReplicatedObjectArray.CreateRangeIndex(PropertyName);
+}
+
+bool ABA_ReplicationInfo::RemoveRangeIndex(FName PropertyName)
+{
+    return ReplicatedObjectArray.RemoveRangeIndex(PropertyName);
+}
+
+void ABA_ReplicationInfo::FindEntriesInRange(FName PropertyName, double Min, double Max, int32 MaxCount, bool& IndexFound, TArray<FGuid>& InstanceGuids)
+{
+    InstanceGuids.Reset();
+    const FBA_FRangeIndex* Index = ReplicatedObjectArray.FindRangeIndex(PropertyName);
+    IndexFound = Index != nullptr;
+    if (!Index)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Property '{property}' has no range index"
+            , __FUNCTION__, PropertyName);
+        return;
+    }
+    TArray<FBA_FEntryHandle> Handles;
+    Index->GetRange(Min, Max, MaxCount, Handles);
+    GetGuidsOfHandles(Handles, InstanceGuids);
+}
+
+void ABA_ReplicationInfo::GetEntriesByRank(FName PropertyName, int32 First, int32 Count, bool bDescending, bool& IndexFound, TArray<FGuid>& InstanceGuids)
+{
+    InstanceGuids.Reset();
+    const FBA_FRangeIndex* Index = ReplicatedObjectArray.FindRangeIndex(PropertyName);
+    IndexFound = Index != nullptr;
+    if (!Index)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Property '{property}' has no range index"
+            , __FUNCTION__, PropertyName);
+        return;
+    }
+    TArray<FBA_FEntryHandle> Handles;
+    Index->GetByRank(First, Count, bDescending, Handles);
+    GetGuidsOfHandles(Handles, InstanceGuids);
+}
+
+bool ABA_ReplicationInfo::CreateFilteredView(FName ViewName, const FBA_FQuery& Query)
+{
+    return ReplicatedObjectArray.CreateFilteredView(ViewName, Query);
+}
+
+bool ABA_ReplicationInfo::RemoveFilteredView(FName ViewName)
+{
+    return ReplicatedObjectArray.RemoveFilteredView(ViewName);
+}
+
+void ABA_ReplicationInfo::GetFilteredView(FName ViewName, bool& Found, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids)
+{
+    Objects.Reset();
+    InstanceGuids.Reset();
+    const FBA_FFilteredView* View = ReplicatedObjectArray.FindFilteredView(ViewName);
+    Found = View != nullptr;
+    if (!View)
+    {
+        return;
+    }
+    Objects.Reserve(View->NumVisible());
+    InstanceGuids.Reserve(View->NumVisible());
+    for (int32 Position = 0; Position < ReplicatedObjectArray.Items.Num(); Position++)
+    {
+        if (View->IsVisible(ReplicatedObjectArray.EntrySlots.GetHandle(Position)))
+        {
+            const FBA_FFA_Object& Entry = ReplicatedObjectArray.Items[Position];
+            Objects.Add(GetCachedEntryObject(Entry));
+            InstanceGuids.Add(Entry.InstanceGuid);
+        }
+    }
+}
+
+EBA_EEntryStatus ABA_ReplicationInfo::GetEntryFilterStatus(FName ViewName, FGuid Guid)
+{
+    const FBA_FFilteredView* View = ReplicatedObjectArray.FindFilteredView(ViewName);
+    return View ? View->GetStatus(ReplicatedObjectArray.GetEntryHandle(Guid)) : EBA_EEntryStatus::E_UNDEFINED;
+}
+
+bool ABA_ReplicationInfo::Aggregate(FName PropertyName, EBA_EAggregateOp Op, FName FilterViewName, double Threshold, double& Result, int32& Count)
+{
+    if (!ReplicatedObjectArray.Aggregate(PropertyName, Op, FilterViewName, Threshold, Result, Count))
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Filtered view '{view}' not found"
+            , __FUNCTION__, FilterViewName);
+        return false;
+    }
+    return true;
+}
+
+#pragma endregion
+
+#pragma region Paging
+
+void ABA_ReplicationInfo::GetPage(int32 Offset, int32 Count, FName ViewName, bool bPrefetchNextPage, bool& Found, int32& TotalCount, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids)
+{
+    Objects.Reset();
+    InstanceGuids.Reset();
+    TArray<FBA_FEntryHandle> Handles;
+    Found = ReplicatedObjectArray.GetViewPage(ViewName, Offset, Count, FBA_FEntryHandle(), false, Handles, TotalCount);
+    if (!Found)
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: View '{view}' not found"
+            , __FUNCTION__, ViewName);
+        return;
+    }
+    GetObjectsOfHandles(Handles, Objects, InstanceGuids);
+    if (bPrefetchNextPage && Count > 0 && Handles.Num() == Count)
+    {
+        PrefetchPage(ViewName, Offset + Count, Count, Handles.Last(), false);
+    }
+}
+
+FBA_FPageCursor ABA_ReplicationInfo::MakePageCursor(FName ViewName, int32 PageSize, int32 Offset)
+{
+    return FBA_FPageCursor(ViewName, FMath::Max(PageSize, 0), FMath::Max(Offset, 0));
+}
+
+bool ABA_ReplicationInfo::NextPage(FBA_FPageCursor& Cursor, bool bPrefetchNextPage, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids)
+{
+    Objects.Reset();
+    InstanceGuids.Reset();
+    if (Cursor.bEnd || Cursor.PageSize <= 0)
+    {
+        return false;
+    }
+    TArray<FBA_FEntryHandle> Handles;
+    if (int32 TotalCount;
+        !ReplicatedObjectArray.GetViewPage(Cursor.ViewName, Cursor.Offset, Cursor.PageSize, Cursor.Last, true, Handles, TotalCount))
+    {
+        UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: View '{view}' not found"
+            , __FUNCTION__, Cursor.ViewName);
+        Cursor.bEnd = true;
+        return false;
+    }
+    GetObjectsOfHandles(Handles, Objects, InstanceGuids);
+    Cursor.Offset += Handles.Num();
+    Cursor.bEnd = Handles.Num() < Cursor.PageSize;
+    if (!Handles.IsEmpty())
+    {
+        Cursor.Last = Handles.Last();
+    }
+    if (bPrefetchNextPage && !Cursor.bEnd)
+    {
+        PrefetchPage(Cursor.ViewName, Cursor.Offset, Cursor.PageSize, Cursor.Last, true);
+    }
+    return !Handles.IsEmpty();
+}
+
+#pragma endregion
+
+#pragma region Statistics
+
+void ABA_ReplicationInfo::GetStatisticsOrderValues(FName PropertyName, bool& Found, double& Min, double& Max, double& Median)
+{
+    FBA_FStatistics* Statistics = FindStatistics(PropertyName);
+    Found = Statistics != nullptr;
+    Min = Statistics ? Statistics->GetMin() : 0;
+    Max = Statistics ? Statistics->GetMax() : 0;
+    Median = Statistics ? Statistics->GetMedian() : 0;
+}
+
+void ABA_ReplicationInfo::GetStatisticsMoments(FName PropertyName, bool& Found, double& Mean, double& Variance, double& StandardDeviation, double& Skewness)
+{
+    FBA_FStatistics* Statistics = FindStatistics(PropertyName);
+    Found = Statistics != nullptr;
+    Mean = Statistics ? Statistics->GetMean() : 0;
+    Variance = Statistics ? Statistics->GetVariance() : 0;
+    StandardDeviation = Statistics ? Statistics->GetStandardDeviation() : 0;
+    Skewness = Statistics ? Statistics->GetSkewness() : 0;
+}
+
+bool ABA_ReplicationInfo::GetStatisticsKthSmallest(FName PropertyName, int32 K, double& Value)
+{
+    const FBA_FStatistics* Statistics = FindStatistics(PropertyName);
+    return Statistics && Statistics->GetKthSmallest(K, Value);
+}
+
+void ABA_ReplicationInfo::GetStatisticsQuantiles(FName PropertyName, const TArray<double>& Fractions, bool& Found, TArray<double>& Values)
+{
+    Values.Reset();
+    const FBA_FStatistics* Statistics = FindStatistics(PropertyName);
+    Found = Statistics != nullptr;
+    for (const double Fraction : Fractions)
+    {
+        double Value = 0;
+        Found &= Statistics && Statistics->GetQuantile(Fraction, Value);
+        Values.Add(Value);
+    }
+}
+
+void ABA_ReplicationInfo::GetStatisticsHistogram(FName PropertyName, bool& Found, double& RangeMin, double& RangeMax, TArray<int32>& Bins)
+{
+    const FBA_FStatistics* Statistics = FindStatistics(PropertyName);
+    Found = Statistics && Statistics->HasSketches();
+    RangeMin = Found ? Statistics->GetHistogram().GetRangeMin() : 0;
+    RangeMax = Found ? Statistics->GetHistogram().GetRangeMax() : 0;
+    Bins = Found ? Statistics->GetHistogram().GetBins() : TArray<int32>();
+}
+
 #pragma endregion
 
 #pragma region Misc Helper
 
 void ABA_ReplicationInfo::BindEvents()
 {
+    // entries can arrive before the shared payload they reference
+    SharedPayloadStore.OnPayloadReceived.BindLambda([this](int32 PayloadId)
+        {
+            this->ReplicatedObjectArray.ResolveSharedPayload(PayloadId);
+        });
     ReplicatedObjectArray.OnEntryPostReplicatedAdd.BindLambda([this](FBA_FFA_Object Entry)
         {
             this->OnEntryPostReplicatedAdd.Broadcast(Entry);
@@ -260,12 +889,15 @@ void ABA_ReplicationInfo::BindEvents()
         });
     ReplicatedObjectArray.OnEntryPostReplicatedChange.BindLambda([this](FBA_FFA_Object Entry)
         {
+            // a changed patch is applied to the cached object on the next read
+            this->ObjectCache.InvalidateOutdated(Entry.InstanceGuid, Entry.PayloadRevision);
             this->OnEntryPostReplicatedChange.Broadcast(Entry);
             UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: OnEntryPostReplicatedChange: {entry}"
                 , __FUNCTION__, Entry.ToString());
         });
     ReplicatedObjectArray.OnEntryPreReplicatedRemove.BindLambda([this](FBA_FFA_Object Entry)
         {
+            this->ObjectCache.Invalidate(Entry.InstanceGuid);
             this->OnEntryPreReplicatedRemove.Broadcast(Entry);
             UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: OnEntryPreReplicatedRemove: {entry}"
                 , __FUNCTION__, Entry.ToString());
@@ -278,91 +910,159 @@ void ABA_ReplicationInfo::BindEvents()
         });
 }
 
-bool ABA_ReplicationInfo::LoadFileToArray(FString FileName, TArray<FName>& TargetArray)
+void ABA_ReplicationInfo::GetGuidsOfHandles(const TArray<FBA_FEntryHandle>& Handles, TArray<FGuid>& InstanceGuids) const
 {
-    // check plugin name 
-    FString PluginName = TEXT("BA_RepArray");
-    TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(PluginName);
-    if (!Plugin.IsValid())
+    InstanceGuids.Reserve(InstanceGuids.Num() + Handles.Num());
+    for (const FBA_FEntryHandle& Handle : Handles)
     {
-        UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Plugin name '{plugin}' is not valid"
-            , __FUNCTION__, PluginName);
-        return false;
+        if (const FBA_FFA_Object* Entry = ReplicatedObjectArray.FindEntry(Handle))
+        {
+            InstanceGuids.Add(Entry->InstanceGuid);
+        }
     }
-    // get resource dir and check file
-    const FString ResourceDir = "Resources";
-    const FString DataFilesDir = "DataFiles";
-    const FString FilePath = FPaths::Combine(
-        *Plugin->GetBaseDir()
-        , *ResourceDir
-        , *DataFilesDir
-        , *FileName);
+}
 
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.FileExists(*FilePath))
+void ABA_ReplicationInfo::GetObjectsOfHandles(const TArray<FBA_FEntryHandle>& Handles, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids)
+{
+    Objects.Reserve(Objects.Num() + Handles.Num());
+    InstanceGuids.Reserve(InstanceGuids.Num() + Handles.Num());
+    for (const FBA_FEntryHandle& Handle : Handles)
     {
-        UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: File '{file}' does not exist"
-            , __FUNCTION__, FilePath);
-        return false;
+        if (const FBA_FFA_Object* Entry = ReplicatedObjectArray.FindEntry(Handle))
+        {
+            Objects.Add(GetCachedEntryObject(*Entry));
+            InstanceGuids.Add(Entry->InstanceGuid);
+        }
     }
-    // load file
-    TArray<FString> Lines;
-    if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+}
+
+void ABA_ReplicationInfo::PrefetchPage(FName ViewName, int32 Offset, int32 Count, const FBA_FEntryHandle& After, bool bSlotOrder)
+{
+    // the prefetched page must not evict the page that was just returned
+    if (ObjectCache.GetCapacity() < Count * 2)
     {
-        UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Error loading file '{file}'"
-            , __FUNCTION__, FilePath);
-        return false;
+        UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Prefetch of {count} entries skipped, object cache capacity is {capacity}"
+            , __FUNCTION__, Count, ObjectCache.GetCapacity());
+        return;
     }
-    TargetArray.Empty();
-    for (FString Line : Lines)
+    GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this, ViewName, Offset, Count, After, bSlotOrder]()
+        {
+            TArray<FBA_FEntryHandle> Handles;
+            if (int32 TotalCount;
+                !ReplicatedObjectArray.GetViewPage(ViewName, Offset, Count, After, bSlotOrder, Handles, TotalCount))
+            {
+                return;
+            }
+            for (const FBA_FEntryHandle& Handle : Handles)
+            {
+                if (const FBA_FFA_Object* Entry = ReplicatedObjectArray.FindEntry(Handle))
+                {
+                    GetCachedEntryObject(*Entry);
+                }
+            }
+        }));
+}
+
+UObject* ABA_ReplicationInfo::GetCachedEntryObject(const FBA_FFA_Object& Entry)
+{
+    if (ObjectCache.GetCapacity() <= 0)
     {
-        if (!Line.IsEmpty())
+        return ReplicatedObjectArray.DeserializeEntry(Entry, this);
+    }
+    int32 CachedPatchRevision = 0;
+    if (UObject* CachedObject = ObjectCache.Find(Entry.InstanceGuid, Entry.PayloadRevision, CachedPatchRevision))
+    {
+        if (CachedPatchRevision == Entry.GetPatchRevision())
+        {
+            return CachedObject;
+        }
+        // only properties changed, no need for a new object
+        if (ReplicatedObjectArray.ApplyPropertyPatch(Entry, CachedObject, CachedPatchRevision))
         {
-            TargetArray.Push(FName(Line));
+            ObjectCache.SetPatchRevision(Entry.InstanceGuid, Entry.GetPatchRevision());
+            return CachedObject;
         }
+        ObjectCache.Invalidate(Entry.InstanceGuid);
     }
-
-    UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Loaded '{file}' with {count} entries"
-        , __FUNCTION__, FilePath, TargetArray.Num());
-    return true;
+    UObject* Object = ReplicatedObjectArray.DeserializeEntry(Entry, this);
+    if (Object)
+    {
+        ObjectCache.Add(Entry.InstanceGuid, Object, Entry.PayloadRevision, Entry.GetPatchRevision());
+    }
+    return Object;
 }
 
 FString ABA_ReplicationInfo::GetUniqueName()
 {
-    if (Adjectives.Num() == 0 || Names.Num() == 0)
+    const FBA_FIdentifier Identifier = GenerateIdentifier();
+    if (Identifier.IsGuidBased())
     {
         return FString(); 
     }
-    int32 RandomEntryNumberAdj01 = RandomStream.RandRange(0, (Adjectives.Num() - 1));
-    int32 RandomEntryNumberAdj02 = RandomStream.RandRange(0, (Adjectives.Num() - 1));
-    int32 RandomEntryNumberNames = RandomStream.RandRange(0, (Names.Num() - 1));
+    return Identifier.ToString(FGuid());
+}
+
+FBA_FIdentifier ABA_ReplicationInfo::GenerateIdentifier()
+{
+    // convenience names and adjectives to give better object names
+    const FBA_FIdentifierDictionary& Dictionary = FBA_FIdentifierDictionary::Get();
+    if (!Dictionary.IsValid())
+    {
+        return FBA_FIdentifier();
+    }
+    int32 RandomEntryNumberAdj01 = RandomStream.RandRange(0, (Dictionary.NumAdjectives() - 1));
+    int32 RandomEntryNumberAdj02 = RandomStream.RandRange(0, (Dictionary.NumAdjectives() - 1));
+    int32 RandomEntryNumberNames = RandomStream.RandRange(0, (Dictionary.NumNames() - 1));
 
-    return Adjectives[RandomEntryNumberAdj01].ToString() + Adjectives[RandomEntryNumberAdj02].ToString() + Names[RandomEntryNumberNames].ToString();
+    return FBA_FIdentifier::FromDictionary(RandomEntryNumberAdj01, RandomEntryNumberAdj02, RandomEntryNumberNames);
 }
 
-bool ABA_ReplicationInfo::CheckObjectPropertyForStatistics(TFieldIterator<FProperty> PropIt, UObject* Object, int32& StatPosition, double& PropertyValue)
+const FBA_FStatisticsPlan& ABA_ReplicationInfo::GetStatisticsPlan(const UStruct* Type)
 {
-    bool Result = false;
-    if (!IsValid(Object) || !PropIt->IsA(FNumericProperty::StaticClass()))
+    if (const FBA_FStatisticsPlan* Plan = StatisticsPlans.Find(Type))
     {
-        return Result;
+        return *Plan;
     }
-    StatPosition = INDEX_NONE;
+    FBA_FStatisticsPlan& Plan = StatisticsPlans.Add(Type);
+    Plan.Compile(Type, [this](const FProperty* Property)
+        {
+            const int32 Position = FindOrAddStatistics(Property);
+            return StatisticsArray.IsValidIndex(Position) ? Position : INDEX_NONE;
+        });
+    return Plan;
+}
 
-    FString PropertyName = PropIt->GetName();
-    FString PropertyType = PropIt->GetCPPType();
+FBA_FStatistics* ABA_ReplicationInfo::FindStatistics(FName PropertyName)
+{
+    // same case insensitive match as FindOrAddStatistics
+    return StatisticsArray.FindByPredicate([PropertyName](const FBA_FStatistics& Stat)
+        {
+            return Stat.PropertyName == PropertyName;
+        });
+}
 
-#pragma region Get Index of FBA_FStatistics
-    int32 Index = StatisticsArray.IndexOfByPredicate([PropertyName](FBA_FStatistics Stat)
+int32 ABA_ReplicationInfo::FindOrAddStatistics(const FProperty* Property)
+{
+    FString PropertyName = Property->GetName();
+    FString PropertyType = Property->GetCPPType();
+
+    int32 Index = StatisticsArray.IndexOfByPredicate([&PropertyName](const FBA_FStatistics& Stat)
         {
-            return PropertyName.Equals(Stat.GetPropertyName().ToString(), ESearchCase::IgnoreCase);
+            return PropertyName.Equals(Stat.PropertyName.ToString(), ESearchCase::IgnoreCase);
         }
     );
     // add if new
     if (Index == INDEX_NONE)
     {
         FBA_FStatistics Stat = FBA_FStatistics(FName(PropertyName), FName(PropertyType));
-        // get value
+        if (bCompensatedStatisticsSum)
+        {
+            Stat.EnableCompensatedSum();
+        }
+        if (bStatisticsSketches)
+        {
+            Stat.EnableSketches(StatisticsSketchK, StatisticsHistogramBins);
+        }
         Index = StatisticsArray.Add(Stat);
     }
     // error here
@@ -370,63 +1070,177 @@ bool ABA_ReplicationInfo::CheckObjectPropertyForStatistics(TFieldIterator<FPrope
     {
         UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Error adding a new FBA_FStatistics to the StatisticsArray"
             , __FUNCTION__, PropertyName, PropertyType);
-        return Result;
     }
-#pragma endregion
+    return Index;
+}
 
+bool ABA_ReplicationInfo::GetStatisticsValueFromPtr(const FProperty* Property, const void* ValuePtr, double& PropertyValue)
+{
     constexpr double Min = TNumericLimits<double>::Min();
     double Value = Min;
 
-    FProperty* Property = *PropIt;
     // check numeric and cast
-    if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+    if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
     {
-        if (NumericProperty && NumericProperty->IsFloatingPoint())
+        if (NumericProperty->IsFloatingPoint())
         {
-            Value = NumericProperty->GetFloatingPointPropertyValue(Property->ContainerPtrToValuePtr<float>(Object));
+            Value = NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
         }
-        else if (NumericProperty && NumericProperty->IsInteger())
+        else if (NumericProperty->IsInteger())
         {
-            int64 IntValue = NumericProperty->GetSignedIntPropertyValue(Property->ContainerPtrToValuePtr<int64>(Object));
+            int64 IntValue = NumericProperty->GetSignedIntPropertyValue(ValuePtr);
             Value = static_cast<double>(IntValue);
         }
     }
 
-    if (Value > Min && StatisticsArray.IsValidIndex(Index))
+    if (Value > Min)
     {
-        StatPosition = Index;
         PropertyValue = Value;
-        Result = true;
+        return true;
     }
-    return Result;
+    return false;
 }
 
-void ABA_ReplicationInfo::UpdateStatistics_Add(UObject* Object)
+void ABA_ReplicationInfo::UpdateStatistics_AddBatch(const TArray<UObject*>& Objects, const TArray<FGuid>& Guids)
 {
-    if (!IsValid(Object)) { return; }
+    // group by class, so every class property column is looked up and updated once
+    TMap<UClass*, TArray<int32>> ObjectsByClass;
+    for (int32 Index = 0; Index < Objects.Num(); Index++)
+    {
+        if (IsValid(Objects[Index]) && Guids.IsValidIndex(Index))
+        {
+            ObjectsByClass.FindOrAdd(Objects[Index]->GetClass()).Add(Index);
+        }
+    }
 
-    for (TFieldIterator<FProperty> PropIt(Object->GetClass()); PropIt; ++PropIt)
+    TArray<double> ColumnValues;
+    for (const TPair<UClass*, TArray<int32>>& ClassObjects : ObjectsByClass)
     {
-        int32 Position; double PropertyValue;
-        
-        if (CheckObjectPropertyForStatistics(PropIt, Object, Position, PropertyValue))
+        for (const FBA_FStatisticsPlan::FStep& Step : GetStatisticsPlan(ClassObjects.Key).GetSteps())
+        {
+            ColumnValues.Reset(ClassObjects.Value.Num());
+            for (const int32 Index : ClassObjects.Value)
+            {
+                if (double Value;
+                    FBA_FStatisticsPlan::ReadValue(Step, Objects[Index], Value))
+                {
+                    ColumnValues.Add(Value);
+                    EntryStatisticsValues.FindOrAdd(Guids[Index]).Emplace(Step.StatPosition, Value);
+                }
+            }
+            StatisticsArray[Step.StatPosition].AddValues(ColumnValues);
+        }
+    }
+}
+
+void ABA_ReplicationInfo::UpdateStatistics_RemoveBatch(const TArray<FGuid>& Guids)
+{
+    // collect the recorded values per statistics column
+    TMap<int32, TArray<double>> ColumnValues;
+    for (const FGuid& Guid : Guids)
+    {
+        TArray<TPair<int32, double>> EntryValues;
+        if (!EntryStatisticsValues.RemoveAndCopyValue(Guid, EntryValues))
+        {
+            continue;
+        }
+        for (const TPair<int32, double>& EntryValue : EntryValues)
         {
-            StatisticsArray[Position].AddValue(PropertyValue);
+            ColumnValues.FindOrAdd(EntryValue.Key).Add(EntryValue.Value);
+        }
+    }
+    for (const TPair<int32, TArray<double>>& Column : ColumnValues)
+    {
+        if (StatisticsArray.IsValidIndex(Column.Key))
+        {
+            StatisticsArray[Column.Key].RemoveValues(Column.Value);
         }
     }
 }
 
-void ABA_ReplicationInfo::UpdateStatistics_Remove(UObject* Object)
+void ABA_ReplicationInfo::UpdateStatistics_Add(const FGuid& Guid, UObject* Object)
 {
     if (!IsValid(Object)) { return; }
 
-    for (TFieldIterator<FProperty> PropIt(Object->GetClass()); PropIt; ++PropIt)
+    UpdateStatistics_Add(Guid, Object->GetClass(), Object);
+}
+
+void ABA_ReplicationInfo::UpdateStatistics_Add(const FGuid& Guid, const UStruct* Type, const void* Container)
+{
+    if (!Type || !Container) { return; }
+
+    const FBA_FStatisticsPlan& Plan = GetStatisticsPlan(Type);
+    TArray<TPair<int32, double>>& EntryValues = EntryStatisticsValues.FindOrAdd(Guid);
+    for (const FBA_FStatisticsPlan::FStep& Step : Plan.GetSteps())
+    {
+        if (double PropertyValue;
+            FBA_FStatisticsPlan::ReadValue(Step, Container, PropertyValue))
+        {
+            StatisticsArray[Step.StatPosition].AddValue(PropertyValue);
+            EntryValues.Emplace(Step.StatPosition, PropertyValue);
+        }
+    }
+}
+
+void ABA_ReplicationInfo::UpdateStatistics_Change(const FGuid& Guid, const UStruct* Type, const void* Container)
+{
+    if (!Type || !Container) { return; }
+
+    for (const FBA_FStatisticsPlan::FStep& Step : GetStatisticsPlan(Type).GetSteps())
     {
-        int32 Position; double PropertyValue;
+        TOptional<double> NewValue;
+        if (double PropertyValue;
+            FBA_FStatisticsPlan::ReadValue(Step, Container, PropertyValue))
+        {
+            NewValue = PropertyValue;
+        }
+        UpdateStatistics_ChangePosition(Guid, Step.StatPosition, NewValue);
+    }
+}
+
+void ABA_ReplicationInfo::UpdateStatistics_Change(const FGuid& Guid, const FProperty* Property, TOptional<double> NewValue)
+{
+    if (!Property || !Property->IsA(FNumericProperty::StaticClass())) { return; }
 
-        if (CheckObjectPropertyForStatistics(PropIt, Object, Position, PropertyValue))
+    UpdateStatistics_ChangePosition(Guid, FindOrAddStatistics(Property), NewValue);
+}
+
+void ABA_ReplicationInfo::UpdateStatistics_ChangePosition(const FGuid& Guid, int32 Position, TOptional<double> NewValue)
+{
+    if (!StatisticsArray.IsValidIndex(Position)) { return; }
+
+    TArray<TPair<int32, double>>& EntryValues = EntryStatisticsValues.FindOrAdd(Guid);
+    const int32 ValueIndex = EntryValues.IndexOfByPredicate([Position](const TPair<int32, double>& EntryValue)
+        {
+            return EntryValue.Key == Position;
+        });
+    // unchanged values do not touch the statistics
+    if (ValueIndex != INDEX_NONE && NewValue.IsSet() && EntryValues[ValueIndex].Value == NewValue.GetValue())
+    {
+        return;
+    }
+    if (ValueIndex != INDEX_NONE)
+    {
+        StatisticsArray[Position].RemoveValue(EntryValues[ValueIndex].Value);
+        EntryValues.RemoveAtSwap(ValueIndex);
+    }
+    if (NewValue.IsSet())
+    {
+        StatisticsArray[Position].AddValue(NewValue.GetValue());
+        EntryValues.Emplace(Position, NewValue.GetValue());
+    }
+}
+
+void ABA_ReplicationInfo::UpdateStatistics_Remove(const FGuid& Guid)
+{
+    TArray<TPair<int32, double>> EntryValues;
+    if (!EntryStatisticsValues.RemoveAndCopyValue(Guid, EntryValues)) { return; }
+
+    for (const TPair<int32, double>& EntryValue : EntryValues)
+    {
+        if (StatisticsArray.IsValidIndex(EntryValue.Key))
         {
-            StatisticsArray[Position].RemoveValue(PropertyValue);
+            StatisticsArray[EntryValue.Key].RemoveValue(EntryValue.Value);
         }
     }
 }
@@ -442,6 +1256,8 @@ void ABA_ReplicationInfo::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 
     FDoRepLifetimeParams Params;
     Params.bIsPushBased = false;
+    DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ClassTable, Params);
+    DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SharedPayloadStore, Params);
     DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ReplicatedObjectArray, Params);
     DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, RandomStream, Params);
     DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, StatisticsArray, Params);
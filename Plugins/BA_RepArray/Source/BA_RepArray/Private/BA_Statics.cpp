@@ -0,0 +1,40 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "BA_Statics.h"
+#include "UObject/ObjectKey.h"
+
+#pragma region Property Table
+
+namespace
+{
+    TMap<TObjectKey<UStruct>, TArray<FProperty*>> PropertyTables;
+}
+
+const TArray<FProperty*>& BA_Statics::GetPropertyTable(const UStruct* Type)
+{
+    static const TArray<FProperty*> EmptyTable;
+    if (!Type)
+    {
+        return EmptyTable;
+    }
+    if (TArray<FProperty*>* Table = PropertyTables.Find(Type))
+    {
+        return *Table;
+    }
+    TArray<FProperty*>& Table = PropertyTables.Add(Type);
+    for (TFieldIterator<FProperty> PropIt(Type); PropIt; ++PropIt)
+    {
+        if (!PropIt->HasAnyPropertyFlags(CPF_Transient | CPF_Deprecated | CPF_SkipSerialization))
+        {
+            Table.Add(*PropIt);
+        }
+    }
+    return Table;
+}
+
+void BA_Statics::ResetPropertyTables()
+{
+    PropertyTables.Empty();
+}
+
+#pragma endregion
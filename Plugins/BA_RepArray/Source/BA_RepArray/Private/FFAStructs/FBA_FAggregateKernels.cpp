@@ -0,0 +1,199 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FAggregateKernels.h"
+#include "Containers/StaticArray.h"
+
+namespace
+{
+	constexpr int32 LaneCount = 4;
+
+	// select mask for every combination of four mask bits
+	const VectorRegister4Double& GetLaneMask(uint32 Bits)
+	{
+		static const TStaticArray<VectorRegister4Double, 16> LaneMasks = []()
+			{
+				TStaticArray<VectorRegister4Double, 16> Masks;
+				for (uint32 Combination = 0; Combination < 16; Combination++)
+				{
+					Masks[Combination] = VectorCompareGT(MakeVectorRegisterDouble(
+						static_cast<double>(Combination & 1)
+						, static_cast<double>((Combination >> 1) & 1)
+						, static_cast<double>((Combination >> 2) & 1)
+						, static_cast<double>((Combination >> 3) & 1))
+						, VectorZeroDouble());
+				}
+				return Masks;
+			}();
+		return LaneMasks[Bits & 0xF];
+	}
+
+	// four mask bits starting at Row (a multiple of four, never crossing a word)
+	uint32 GetLaneBits(const uint32* MaskWords, int32 Row)
+	{
+		return (MaskWords[Row / NumBitsPerDWORD] >> (Row % NumBitsPerDWORD)) & 0xF;
+	}
+
+	double HorizontalSum(const VectorRegister4Double& Vector)
+	{
+		alignas(32) double Lanes[LaneCount];
+		VectorStore(Vector, Lanes);
+		return (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+	}
+}
+
+double FBA_FAggregateKernels::Sum(const double* Values, const TBitArray<>& Mask, int32& OutCount)
+{
+	const int32 Num = Mask.Num();
+	const uint32* MaskWords = Mask.GetData();
+	const int32 VectorNum = Num - Num % LaneCount;
+	const VectorRegister4Double One = VectorOneDouble();
+
+	VectorRegister4Double SumVector = VectorZeroDouble();
+	VectorRegister4Double CountVector = VectorZeroDouble();
+	for (int32 Row = 0; Row < VectorNum; Row += LaneCount)
+	{
+		const uint32 Bits = GetLaneBits(MaskWords, Row);
+		if (Bits == 0)
+		{
+			continue;
+		}
+		const VectorRegister4Double& LaneMask = GetLaneMask(Bits);
+		SumVector = VectorAdd(SumVector, VectorSelect(LaneMask, VectorLoad(Values + Row), VectorZeroDouble()));
+		CountVector = VectorAdd(CountVector, VectorSelect(LaneMask, One, VectorZeroDouble()));
+	}
+	double Sum = HorizontalSum(SumVector);
+	int32 Count = static_cast<int32>(HorizontalSum(CountVector));
+	for (int32 Row = VectorNum; Row < Num; Row++)
+	{
+		if (Mask[Row])
+		{
+			Sum += Values[Row];
+			Count++;
+		}
+	}
+	OutCount = Count;
+	return Sum;
+}
+
+double FBA_FAggregateKernels::Sum(const int64* Values, const TBitArray<>& Mask, int32& OutCount)
+{
+	// exact integer sum, converted once
+	int64 Sum = 0;
+	int32 Count = 0;
+	for (TConstSetBitIterator<> It(Mask); It; ++It)
+	{
+		Sum += Values[It.GetIndex()];
+		Count++;
+	}
+	OutCount = Count;
+	return static_cast<double>(Sum);
+}
+
+bool FBA_FAggregateKernels::MinMax(const double* Values, const TBitArray<>& Mask, double& OutMin, double& OutMax)
+{
+	const int32 Num = Mask.Num();
+	const uint32* MaskWords = Mask.GetData();
+	const int32 VectorNum = Num - Num % LaneCount;
+	const VectorRegister4Double PositiveInfinity = VectorSetFloat1(TNumericLimits<double>::Max());
+	const VectorRegister4Double NegativeInfinity = VectorSetFloat1(TNumericLimits<double>::Lowest());
+
+	bool bFound = false;
+	VectorRegister4Double MinVector = PositiveInfinity;
+	VectorRegister4Double MaxVector = NegativeInfinity;
+	for (int32 Row = 0; Row < VectorNum; Row += LaneCount)
+	{
+		const uint32 Bits = GetLaneBits(MaskWords, Row);
+		if (Bits == 0)
+		{
+			continue;
+		}
+		bFound = true;
+		const VectorRegister4Double& LaneMask = GetLaneMask(Bits);
+		const VectorRegister4Double Lane = VectorLoad(Values + Row);
+		MinVector = VectorMin(MinVector, VectorSelect(LaneMask, Lane, PositiveInfinity));
+		MaxVector = VectorMax(MaxVector, VectorSelect(LaneMask, Lane, NegativeInfinity));
+	}
+	alignas(32) double MinLanes[LaneCount];
+	alignas(32) double MaxLanes[LaneCount];
+	VectorStore(MinVector, MinLanes);
+	VectorStore(MaxVector, MaxLanes);
+	double Min = FMath::Min(FMath::Min(MinLanes[0], MinLanes[1]), FMath::Min(MinLanes[2], MinLanes[3]));
+	double Max = FMath::Max(FMath::Max(MaxLanes[0], MaxLanes[1]), FMath::Max(MaxLanes[2], MaxLanes[3]));
+	for (int32 Row = VectorNum; Row < Num; Row++)
+	{
+		if (Mask[Row])
+		{
+			bFound = true;
+			Min = FMath::Min(Min, Values[Row]);
+			Max = FMath::Max(Max, Values[Row]);
+		}
+	}
+	if (bFound)
+	{
+		OutMin = Min;
+		OutMax = Max;
+	}
+	return bFound;
+}
+
+bool FBA_FAggregateKernels::MinMax(const int64* Values, const TBitArray<>& Mask, double& OutMin, double& OutMax)
+{
+	TConstSetBitIterator<> It(Mask);
+	if (!It)
+	{
+		return false;
+	}
+	int64 Min = Values[It.GetIndex()];
+	int64 Max = Min;
+	for (; It; ++It)
+	{
+		Min = FMath::Min(Min, Values[It.GetIndex()]);
+		Max = FMath::Max(Max, Values[It.GetIndex()]);
+	}
+	OutMin = static_cast<double>(Min);
+	OutMax = static_cast<double>(Max);
+	return true;
+}
+
+int32 FBA_FAggregateKernels::CountAbove(const double* Values, const TBitArray<>& Mask, double Threshold)
+{
+	const int32 Num = Mask.Num();
+	const uint32* MaskWords = Mask.GetData();
+	const int32 VectorNum = Num - Num % LaneCount;
+	const VectorRegister4Double One = VectorOneDouble();
+	const VectorRegister4Double ThresholdVector = VectorSetFloat1(Threshold);
+
+	VectorRegister4Double CountVector = VectorZeroDouble();
+	for (int32 Row = 0; Row < VectorNum; Row += LaneCount)
+	{
+		const uint32 Bits = GetLaneBits(MaskWords, Row);
+		if (Bits == 0)
+		{
+			continue;
+		}
+		const VectorRegister4Double Above = VectorBitwiseAnd(GetLaneMask(Bits), VectorCompareGT(VectorLoad(Values + Row), ThresholdVector));
+		CountVector = VectorAdd(CountVector, VectorSelect(Above, One, VectorZeroDouble()));
+	}
+	int32 Count = static_cast<int32>(HorizontalSum(CountVector));
+	for (int32 Row = VectorNum; Row < Num; Row++)
+	{
+		if (Mask[Row] && Values[Row] > Threshold)
+		{
+			Count++;
+		}
+	}
+	return Count;
+}
+
+int32 FBA_FAggregateKernels::CountAbove(const int64* Values, const TBitArray<>& Mask, double Threshold)
+{
+	int32 Count = 0;
+	for (TConstSetBitIterator<> It(Mask); It; ++It)
+	{
+		if (static_cast<double>(Values[It.GetIndex()]) > Threshold)
+		{
+			Count++;
+		}
+	}
+	return Count;
+}
@@ -0,0 +1,49 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FClassTable.h"
+#include "Logging/StructuredLog.h"
+#include "BA_RepArray.h"
+
+#pragma region FBA_FPackedIndex
+
+bool FBA_FPackedIndex::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// shifted by one, so INDEX_NONE is sent as 0
+	uint32 PackedIndex = static_cast<uint32>(Index + 1);
+	Ar.SerializeIntPacked(PackedIndex);
+	if (Ar.IsLoading())
+	{
+		Index = static_cast<int32>(PackedIndex) - 1;
+	}
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+#pragma endregion
+
+#pragma region FBA_FClassTable
+
+int32 FBA_FClassTable::FindOrAdd(UStruct* Type)
+{
+	if (!Type)
+	{
+		return INDEX_NONE;
+	}
+	if (const int32* IndexPtr = TypeToIndex.Find(Type))
+	{
+		return *IndexPtr;
+	}
+	const int32 ClassIndex = Types.Add(Type);
+	TypeToIndex.Add(Type, ClassIndex);
+	UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Type '{type}' added to class table at index {index}"
+		, __FUNCTION__, Type->GetName(), ClassIndex);
+	return ClassIndex;
+}
+
+void FBA_FClassTable::Clear()
+{
+	Types.Empty();
+	TypeToIndex.Empty();
+}
+
+#pragma endregion
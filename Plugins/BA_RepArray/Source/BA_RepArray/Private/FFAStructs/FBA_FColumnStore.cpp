@@ -0,0 +1,161 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FColumnStore.h"
+
+#pragma region FBA_FNumericColumn
+
+void FBA_FNumericColumn::SetNum(int32 NumRows)
+{
+	if (Present.Num() >= NumRows)
+	{
+		return;
+	}
+	if (bInteger)
+	{
+		Integers.SetNumZeroed(NumRows);
+	}
+	else
+	{
+		Doubles.SetNumZeroed(NumRows);
+	}
+	Present.SetNum(NumRows, false);
+}
+
+void FBA_FNumericColumn::SetInteger(int32 Row, int64 Value)
+{
+	if (bInteger)
+	{
+		Integers[Row] = Value;
+	}
+	else
+	{
+		Doubles[Row] = static_cast<double>(Value);
+	}
+	if (!Present[Row])
+	{
+		Present[Row] = true;
+		SetCount++;
+	}
+}
+
+void FBA_FNumericColumn::SetDouble(int32 Row, double Value)
+{
+	if (bInteger)
+	{
+		ConvertToDouble();
+	}
+	Doubles[Row] = Value;
+	if (!Present[Row])
+	{
+		Present[Row] = true;
+		SetCount++;
+	}
+}
+
+void FBA_FNumericColumn::ClearRow(int32 Row)
+{
+	if (Present.IsValidIndex(Row) && Present[Row])
+	{
+		Present[Row] = false;
+		SetCount--;
+	}
+}
+
+void FBA_FNumericColumn::ConvertToDouble()
+{
+	Doubles.SetNumUninitialized(Integers.Num());
+	for (int32 Row = 0; Row < Integers.Num(); Row++)
+	{
+		Doubles[Row] = static_cast<double>(Integers[Row]);
+	}
+	Integers.Empty();
+	bInteger = false;
+}
+
+#pragma endregion
+
+#pragma region FBA_FColumnStore
+
+void FBA_FColumnStore::SetRow(int32 Row, const UStruct* EntryType, const void* Container)
+{
+	if (Row < 0)
+	{
+		return;
+	}
+	ClearRow(Row);
+	if (!EntryType || !Container)
+	{
+		return;
+	}
+	if (Row >= RowCount)
+	{
+		// grow geometrically, columns follow on their next write
+		RowCount = FMath::Max(Row + 1, RowCount * 2);
+		RowColumns.SetNum(RowCount);
+	}
+
+	TArray<FName>& Written = RowColumns[Row];
+	for (const FNumericProperty* Property : GetNumericProperties(EntryType))
+	{
+		FBA_FNumericColumn& Column = Columns.FindOrAdd(Property->GetFName());
+		Column.SetNum(RowCount);
+		const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Container);
+		if (Property->IsFloatingPoint())
+		{
+			Column.SetDouble(Row, Property->GetFloatingPointPropertyValue(ValuePtr));
+		}
+		else if (Property->IsA<FUInt64Property>())
+		{
+			Column.SetInteger(Row, static_cast<int64>(Property->GetUnsignedIntPropertyValue(ValuePtr)));
+		}
+		else
+		{
+			Column.SetInteger(Row, Property->GetSignedIntPropertyValue(ValuePtr));
+		}
+		Written.Add(Property->GetFName());
+	}
+}
+
+void FBA_FColumnStore::ClearRow(int32 Row)
+{
+	if (!RowColumns.IsValidIndex(Row))
+	{
+		return;
+	}
+	for (const FName& ColumnName : RowColumns[Row])
+	{
+		if (FBA_FNumericColumn* Column = Columns.Find(ColumnName))
+		{
+			Column->ClearRow(Row);
+		}
+	}
+	RowColumns[Row].Reset();
+}
+
+void FBA_FColumnStore::Clear()
+{
+	Columns.Reset();
+	RowColumns.Reset();
+	RowCount = 0;
+	// the property lists only depend on the types, see ResetTypeCache
+}
+
+const TArray<const FNumericProperty*>& FBA_FColumnStore::GetNumericProperties(const UStruct* EntryType)
+{
+	if (const TArray<const FNumericProperty*>* Properties = NumericProperties.Find(EntryType))
+	{
+		return *Properties;
+	}
+	TArray<const FNumericProperty*>& Properties = NumericProperties.Add(EntryType);
+	for (TFieldIterator<FNumericProperty> PropIt(EntryType); PropIt; ++PropIt)
+	{
+		// static arrays have no single value per entry
+		if (PropIt->ArrayDim == 1)
+		{
+			Properties.Add(*PropIt);
+		}
+	}
+	return Properties;
+}
+
+#pragma endregion
@@ -1,8 +1,10 @@
 // Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
 
 #include "FFAStructs/FBA_FFA_Object.h"
+#include "FFAStructs/FBA_FFA_PayloadStore.h"
 #include "Logging/StructuredLog.h"
 #include "Serialization/BufferArchive.h"
+#include "Misc/Base64.h"
 #include "Serialization/MemoryReader.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "Compression/CompressedBuffer.h"
@@ -16,6 +18,7 @@ FBA_FFA_Object::FBA_FFA_Object(FString SerializedStorageObject, UClass* StorageO
 	if (!SerializedStorageObject.IsEmpty())
 	{
 		SerializedObject = SerializedStorageObject;
+		PayloadFormat = EBA_EPayloadFormat::E_Base64String;
 		InstanceGuid = FGuid::NewGuid();
 		ClassToCastTo = StorageObjectClass;
 		SourceObject = EBA_EEntrySource::E_Object;
@@ -32,6 +35,7 @@ FBA_FFA_Object::FBA_FFA_Object(FGuid Guid, FString SerializedStorageObject, UCla
 	if (!SerializedStorageObject.IsEmpty())
 	{
 		SerializedObject = SerializedStorageObject;
+		PayloadFormat = EBA_EPayloadFormat::E_Base64String;
 		InstanceGuid = Guid;
 		ClassToCastTo = StorageObjectClass;
 		SourceObject = EBA_EEntrySource::E_Object;
@@ -43,11 +47,96 @@ FBA_FFA_Object::FBA_FFA_Object(FGuid Guid, FString SerializedStorageObject, UCla
 	}
 }
 
+FBA_FFA_Object::FBA_FFA_Object(FGuid Guid, FBA_FPayload&& StorageObjectPayload, UClass* StorageObjectClass)
+{
+	if (!StorageObjectPayload.IsEmpty())
+	{
+		Payload = MoveTemp(StorageObjectPayload);
+		PayloadFormat = EBA_EPayloadFormat::E_Binary;
+		InstanceGuid = Guid;
+		ClassToCastTo = StorageObjectClass;
+		SourceObject = EBA_EEntrySource::E_Object;
+	}
+	else
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Serialized object is empty"
+			, __FUNCTION__);
+	}
+}
+
+#pragma endregion
+
+#pragma region Payload
+
+bool FBA_FFA_Object::HasPayload() const
+{
+	if (SharedPayloadId != FBA_FFA_PayloadStore::InvalidPayloadId)
+	{
+		return true;
+	}
+	switch (PayloadFormat)
+	{
+	case EBA_EPayloadFormat::E_Base64String:
+		return !SerializedObject.IsEmpty();
+	case EBA_EPayloadFormat::E_Binary:
+	case EBA_EPayloadFormat::E_DefaultsDelta:
+		return !Payload.IsEmpty();
+	default:
+		return false;
+	}
+}
+
+bool FBA_FFA_Object::ConvertPayloadFormat(EBA_EPayloadFormat NewFormat)
+{
+	// conversions from and to E_DefaultsDelta need the deserialized object, see FBA_FFA_ObjectArray::MigratePayloadFormat
+	if (NewFormat == PayloadFormat || !HasPayload() || SharedPayloadId != FBA_FFA_PayloadStore::InvalidPayloadId)
+	{
+		return false;
+	}
+
+	if (PayloadFormat == EBA_EPayloadFormat::E_Base64String && NewFormat == EBA_EPayloadFormat::E_Binary)
+	{
+		TArray<uint8> BinaryData;
+		if (!FBase64::Decode(SerializedObject, BinaryData))
+		{
+			UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Base64 payload of '{entry}' cannot be decoded"
+				, __FUNCTION__, InstanceGuid.ToString());
+			return false;
+		}
+		Payload = FBA_FPayload(MoveTemp(BinaryData));
+		if (!Payload.FitsNetLimits())
+		{
+			UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Binary payload of '{entry}' exceeds the replication limit"
+				, __FUNCTION__, InstanceGuid.ToString());
+			Payload.Reset();
+			return false;
+		}
+		SerializedObject.Empty();
+	}
+	else if (PayloadFormat == EBA_EPayloadFormat::E_Binary && NewFormat == EBA_EPayloadFormat::E_Base64String)
+	{
+		TArray<uint8> DecompressionBuffer;
+		const TArray<uint8>* BinaryData = Payload.GetUncompressedData(DecompressionBuffer);
+		if (!BinaryData)
+		{
+			return false;
+		}
+		SerializedObject = FBase64::Encode(*BinaryData);
+		Payload.Reset();
+	}
+	else
+	{
+		return false;
+	}
+	PayloadFormat = NewFormat;
+	return true;
+}
+
 #pragma endregion
 
 void FBA_FFA_Object::GetIdentifier(FString& HumanReadableName)
 {
-	HumanReadableName = InstanceIdentifier;
+	HumanReadableName = GetReadableIdentifier();
 }
 
 void FBA_FFA_Object::GetInstanceGuid(FGuid EntryGuid)
@@ -69,11 +158,13 @@ FString FBA_FFA_Object::ToString()
 {
 	return FBA_FFA_Object::StaticStruct()->GetName()
 		+ " '"
-		+ InstanceIdentifier
+		+ GetReadableIdentifier()
 		+ "' ["
 		+ InstanceGuid.ToString()
 		+ "], object type '"
 		+ (IsValid(ClassToCastTo) ? ClassToCastTo->GetDisplayNameText().ToString() : "no class defined yet")
-		+ "', sorting index "
+		+ "', payload "
+		+ StaticEnum<EBA_EPayloadFormat>()->GetNameStringByValue(static_cast<int64>(PayloadFormat))
+		+ ", sorting index "
 		+ FString::FromInt(SortIndex);
 }
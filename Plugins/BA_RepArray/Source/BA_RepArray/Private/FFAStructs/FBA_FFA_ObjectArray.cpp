@@ -6,6 +6,10 @@
 #include "BA_Statics.h"
 #include "Logging/StructuredLog.h"
 #include "Engine/ActorChannel.h"
+#include "Misc/Base64.h"
+#include "Async/ParallelFor.h"
+#include "Algo/StableSort.h"
+#include "FFAStructs/FBA_FAggregateKernels.h"
 
 FBA_FFA_ObjectArray::FBA_FFA_ObjectArray()
 {
@@ -28,132 +32,1410 @@ FBA_FFA_ObjectArray::~FBA_FFA_ObjectArray()
 
 #pragma region CRUD
 
-bool FBA_FFA_ObjectArray::AddEntry(UObject* StorageObject, FGuid InstanceGuid, FString ReadableIdentifier)
+bool FBA_FFA_ObjectArray::AddEntry(UObject* StorageObject, FGuid InstanceGuid, const FBA_FIdentifier& Identifier)
+{
+	FBA_FFA_Object Prototype;
+	if (!PrepareEntry(StorageObject, Prototype))
+	{
+		return false;
+	}
+	const bool bReturn = AddPreparedEntry(Prototype, InstanceGuid, Identifier);
+	ReleasePreparedEntry(Prototype);
+	return bReturn;
+}
+
+bool FBA_FFA_ObjectArray::PrepareEntry(UObject* StorageObject, FBA_FFA_Object& Prototype)
+{
+	if (!StorageObject)
+	{
+		return false;
+	}
+	Prototype = FBA_FFA_Object();
+	Prototype.SourceObject = EBA_EEntrySource::E_Object;
+	Prototype.ClassToCastTo = StorageObject->GetClass();
+	if (ClassTable)
+	{
+		Prototype.ClassIndex = ClassTable->FindOrAdd(Prototype.ClassToCastTo);
+	}
+	if (!WriteEntryPayload(StorageObject, Prototype))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Serialized object is empty"
+			, __FUNCTION__);
+		return false;
+	}
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::PrepareStructEntry(const UScriptStruct* StructType, const void* StructData, FBA_FFA_Object& Prototype)
+{
+	if (!StructType || !StructData)
+	{
+		return false;
+	}
+	Prototype = FBA_FFA_Object();
+	Prototype.SourceObject = EBA_EEntrySource::E_Struct;
+	// struct entries have no class, the struct type is stored in the class table
+	Prototype.ClassToCastTo = nullptr;
+	if (ClassTable)
+	{
+		Prototype.ClassIndex = ClassTable->FindOrAdd(const_cast<UScriptStruct*>(StructType));
+	}
+	if (!Prototype.ClassIndex.IsValid() || !WriteStructPayload(StructType, StructData, Prototype))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Struct '{struct}' cannot be stored"
+			, __FUNCTION__, StructType->GetName());
+		return false;
+	}
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::AddPreparedEntry(const FBA_FFA_Object& Prototype, FGuid InstanceGuid, const FBA_FIdentifier& Identifier)
 {
 	bool bReturn = false;
 
-	if (!StorageObject)
+	FBA_FFA_Object Entry = Prototype;
+	Entry.InstanceGuid = InstanceGuid;
+	Entry.InstanceIdentifier = Identifier;
+	
+	if (int32 Position = Items.Add(MoveTemp(Entry));
+		Position != INDEX_NONE)
+	{
+		// every entry holds its own reference to a shared payload
+		if (SharedPayloadStore && Items[Position].SharedPayloadId != FBA_FFA_PayloadStore::InvalidPayloadId)
+		{
+			SharedPayloadStore->AddReference(Items[Position].SharedPayloadId);
+		}
+		// save position in map for easier access
+		Items[Position].SortIndex = Position;
+		//Entry.SortIndex = Position;
+		IndexEntry(Position);
+		// register with owner
+		/*if (CheckForSubobjectListSupport(Items[Position]))
+		{
+			Owner->AddReplicatedSubObject(Items[Position].ObjectPtr);
+		}*/
+		// update item
+		MarkItemDirty(Items[Position]);
+		bReturn = true;
+		UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Entry '{entry}' newly added to array at position {position}"
+			, __FUNCTION__, Items[Position].ToString(), FString::FromInt(Position));
+	}
+	else
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Error adding Entry '{entry}' to array"
+			, __FUNCTION__, Entry.ToString());
+	}
+
+	return bReturn;
+}
+
+int32 FBA_FFA_ObjectArray::AddEntries(const TArray<UObject*>& StorageObjects, const TArray<FBA_FIdentifier>& Identifiers, TArray<FGuid>& OutInstanceGuids)
+{
+	const int32 NumObjects = StorageObjects.Num();
+	OutInstanceGuids.Init(FGuid(), NumObjects);
+	if (NumObjects == 0)
+	{
+		return 0;
+	}
+
+	// serialization touches the objects and stays on the game thread
+	TArray<FBA_FFA_Object> NewEntries;
+	TArray<TArray<uint8>> SerializedData;
+	NewEntries.SetNum(NumObjects);
+	SerializedData.SetNum(NumObjects);
+	for (int32 Index = 0; Index < NumObjects; Index++)
+	{
+		UObject* StorageObject = StorageObjects[Index];
+		if (!IsValid(StorageObject))
+		{
+			continue;
+		}
+		FBA_FFA_Object& Entry = NewEntries[Index];
+		Entry.SourceObject = EBA_EEntrySource::E_Object;
+		Entry.ClassToCastTo = StorageObject->GetClass();
+		if (ClassTable)
+		{
+			Entry.ClassIndex = ClassTable->FindOrAdd(Entry.ClassToCastTo);
+		}
+		Entry.PayloadFormat = PayloadSettings.Format;
+		SerializeObjectPayload(StorageObject, Entry.PayloadFormat, SerializedData[Index]);
+	}
+
+	// encoding and compression only work on the byte buffers
+	ParallelFor(NumObjects, [this, &NewEntries, &SerializedData](int32 Index)
+		{
+			EncodePayload(MoveTemp(SerializedData[Index]), NewEntries[Index]);
+		});
+
+	Items.Reserve(Items.Num() + NumObjects);
+	EntrySlots.Reserve(Items.Num() + NumObjects);
+	GuidToHandle.Reserve(GuidToHandle.Num() + NumObjects);
+	IdentifierToHandle.Reserve(IdentifierToHandle.Num() + NumObjects);
+
+	int32 AddedCount = 0;
+	for (int32 Index = 0; Index < NumObjects; Index++)
+	{
+		FBA_FFA_Object& Entry = NewEntries[Index];
+		if (!Entry.HasPayload())
+		{
+			continue;
+		}
+		SharePayload(Entry);
+		Entry.InstanceGuid = FGuid::NewGuid();
+		if (Identifiers.IsValidIndex(Index))
+		{
+			Entry.InstanceIdentifier = Identifiers[Index];
+		}
+
+		const int32 Position = Items.Add(MoveTemp(Entry));
+		Items[Position].SortIndex = Position;
+		IndexEntry(Position);
+		MarkItemDirty(Items[Position]);
+		OutInstanceGuids[Index] = Items[Position].InstanceGuid;
+		AddedCount++;
+	}
+
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: {added} of {count} entries added to array"
+		, __FUNCTION__, AddedCount, NumObjects);
+	return AddedCount;
+}
+
+void FBA_FFA_ObjectArray::ReleasePreparedEntry(FBA_FFA_Object& Prototype)
+{
+	ReleaseSharedPayload(Prototype);
+}
+
+void FBA_FFA_ObjectArray::ReleaseSharedPayload(FBA_FFA_Object& Entry)
+{
+	if (SharedPayloadStore && Entry.SharedPayloadId != FBA_FFA_PayloadStore::InvalidPayloadId)
+	{
+		SharedPayloadStore->Release(Entry.SharedPayloadId);
+	}
+	Entry.SharedPayloadId = FBA_FFA_PayloadStore::InvalidPayloadId;
+}
+
+bool FBA_FFA_ObjectArray::UpdateEntryProperties(FGuid InstanceGuid, UObject* ModifiedObject, TArray<FName>& ChangedProperties)
+{
+	ChangedProperties.Reset();
+	const int32 Position = FindPosition(InstanceGuid);
+	if (!ModifiedObject || Position == INDEX_NONE)
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Guid '{guid}' cannot be found or object is not valid"
+			, __FUNCTION__, InstanceGuid.ToString());
+		return false;
+	}
+	FBA_FFA_Object& Entry = Items[Position];
+	if (ModifiedObject->GetClass() != GetEntryClass(Entry))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Class of modified object does not match entry '{entry}'"
+			, __FUNCTION__, Entry.ToString());
+		return false;
+	}
+
+	UObject* CurrentObject = DeserializeEntry(Entry, Owner);
+	if (!CurrentObject)
+	{
+		return false;
+	}
+
+	// collect changed properties (in both modes), keyed by their per-class property index
+	const TArray<FProperty*>& PropertyTable = BA_Statics::GetPropertyTable(GetEntryClass(Entry));
+	TArray<int32> ChangedIndices;
+	for (int32 PropertyIndex = 0; PropertyIndex < PropertyTable.Num() && PropertyIndex <= MAX_uint16; PropertyIndex++)
+	{
+		const FProperty* Property = PropertyTable[PropertyIndex];
+		if (!BA_Statics::IsPropertyIdentical(Property, CurrentObject, ModifiedObject))
+		{
+			ChangedIndices.Add(PropertyIndex);
+			ChangedProperties.Add(Property->GetFName());
+		}
+	}
+
+	// nothing differs, no new revision and nothing to replicate
+	if (ChangedIndices.Num() == 0)
+	{
+		return true;
+	}
+
+	// without delta replication the full payload is replaced
+	if (!PayloadSettings.bPropertyDeltaReplication)
+	{
+		if (!WriteEntryPayload(ModifiedObject, Entry))
+		{
+			ChangedProperties.Reset();
+			return false;
+		}
+		Entry.PropertyPatch.Reset();
+		Entry.PayloadRevision++;
+		MarkItemDirty(Entry);
+		UpdateSecondaryIndexes(Position);
+		return true;
+	}
+
+	Entry.PropertyPatch.BeginRevision();
+	for (const int32 PropertyIndex : ChangedIndices)
+	{
+		TArray<uint8> SerializedValue;
+		BA_Statics::WritePropertyValue(PropertyTable[PropertyIndex], ModifiedObject, SerializedValue);
+		Entry.PropertyPatch.SetValue(static_cast<uint16>(PropertyIndex), MoveTemp(SerializedValue));
+	}
+
+	RebaseIfNeeded(ModifiedObject, Entry);
+	MarkItemDirty(Entry);
+	UpdateSecondaryIndexes(Position);
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::SetEntryProperty(FGuid InstanceGuid, FName PropertyName, const FProperty* ValueProperty, const void* Value, const FProperty*& OutProperty)
+{
+	OutProperty = nullptr;
+	const int32 Position = FindPosition(InstanceGuid);
+	if (!ValueProperty || !Value || Position == INDEX_NONE)
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Guid '{guid}' cannot be found or value is not valid"
+			, __FUNCTION__, InstanceGuid.ToString());
+		return false;
+	}
+	FBA_FFA_Object& Entry = Items[Position];
+
+	// struct entries have no property patches, the payload is always rewritten
+	if (Entry.IsStructEntry())
+	{
+		TSharedPtr<FStructOnScope> CurrentStruct = DeserializeStructEntry(Entry);
+		const UScriptStruct* EntryStruct = GetEntryStruct(Entry);
+		const FProperty* Property = EntryStruct ? EntryStruct->FindPropertyByName(PropertyName) : nullptr;
+		if (!CurrentStruct.IsValid() || !Property || !Property->SameType(ValueProperty))
+		{
+			UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Property '{property}' of entry '{entry}' not found or of different type"
+				, __FUNCTION__, PropertyName, Entry.ToString());
+			return false;
+		}
+		Property->CopyCompleteValue(Property->ContainerPtrToValuePtr<void>(CurrentStruct->GetStructMemory()), Value);
+		if (!WriteStructPayload(EntryStruct, CurrentStruct->GetStructMemory(), Entry))
+		{
+			return false;
+		}
+		Entry.PayloadRevision++;
+		MarkItemDirty(Entry);
+		UpdateSecondaryIndexes(Position);
+		OutProperty = Property;
+		return true;
+	}
+
+	UObject* CurrentObject = DeserializeEntry(Entry, Owner);
+	if (!CurrentObject)
+	{
+		return false;
+	}
+	const TArray<FProperty*>& PropertyTable = BA_Statics::GetPropertyTable(GetEntryClass(Entry));
+	const int32 PropertyIndex = PropertyTable.IndexOfByPredicate([PropertyName](const FProperty* Property)
+		{
+			return Property->GetFName() == PropertyName;
+		});
+	if (PropertyIndex == INDEX_NONE || !PropertyTable[PropertyIndex]->SameType(ValueProperty))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Property '{property}' of entry '{entry}' not found or of different type"
+			, __FUNCTION__, PropertyName, Entry.ToString());
+		return false;
+	}
+	const FProperty* Property = PropertyTable[PropertyIndex];
+	if (Property->Identical(Property->ContainerPtrToValuePtr<void>(CurrentObject), Value, PPF_None))
+	{
+		// nothing to replicate
+		OutProperty = Property;
+		return true;
+	}
+	Property->CopyCompleteValue(Property->ContainerPtrToValuePtr<void>(CurrentObject), Value);
+
+	if (PayloadSettings.bPropertyDeltaReplication && PropertyIndex <= MAX_uint16)
+	{
+		TArray<uint8> SerializedValue;
+		BA_Statics::WritePropertyValue(Property, CurrentObject, SerializedValue);
+		Entry.PropertyPatch.BeginRevision();
+		Entry.PropertyPatch.SetValue(static_cast<uint16>(PropertyIndex), MoveTemp(SerializedValue));
+		RebaseIfNeeded(CurrentObject, Entry);
+	}
+	else
+	{
+		if (!WriteEntryPayload(CurrentObject, Entry))
+		{
+			return false;
+		}
+		Entry.PropertyPatch.Reset();
+		Entry.PayloadRevision++;
+	}
+	MarkItemDirty(Entry);
+	UpdateSecondaryIndexes(Position);
+	OutProperty = Property;
+	return true;
+}
+
+void FBA_FFA_ObjectArray::RebaseIfNeeded(UObject* CurrentObject, FBA_FFA_Object& Entry)
+{
+	// fold the patch back into the payload once it stops paying off
+	if (Entry.PropertyPatch.GetByteSize() > GetEntryPayloadSize(Entry) * PayloadSettings.PatchRebaseRatio)
+	{
+		if (WriteEntryPayload(CurrentObject, Entry))
+		{
+			Entry.PropertyPatch.Reset();
+			Entry.PayloadRevision++;
+			UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Entry '{entry}' rebased to payload revision {revision}"
+				, __FUNCTION__, Entry.ToString(), Entry.PayloadRevision);
+		}
+	}
+}
+
+bool FBA_FFA_ObjectArray::WriteEntryPayload(UObject* StorageObject, FBA_FFA_Object& Entry)
+{
+	TArray<uint8> BinaryData;
+	return SerializeObjectPayload(StorageObject, PayloadSettings.Format, BinaryData)
+		&& ReplaceEntryPayload(MoveTemp(BinaryData), PayloadSettings.Format, Entry);
+}
+
+bool FBA_FFA_ObjectArray::SerializeObjectPayload(UObject* StorageObject, EBA_EPayloadFormat Format, TArray<uint8>& OutBytes)
+{
+	if (Format == EBA_EPayloadFormat::E_DefaultsDelta)
+	{
+		return BA_Statics::SerializeObjectDeltaToDefaults(StorageObject, OutBytes);
+	}
+	// Base64 payloads are encoded from the same bytes
+	return BA_Statics::SerializeObjectToBytes(StorageObject, OutBytes);
+}
+
+bool FBA_FFA_ObjectArray::WriteStructPayload(const UScriptStruct* StructType, const void* StructData, FBA_FFA_Object& Entry)
+{
+	// struct entries are always stored as binary payload
+	TArray<uint8> BinaryData;
+	return BA_Statics::SerializeStructToBytes(StructType, StructData, BinaryData)
+		&& ReplaceEntryPayload(MoveTemp(BinaryData), EBA_EPayloadFormat::E_Binary, Entry);
+}
+
+bool FBA_FFA_ObjectArray::ReplaceEntryPayload(TArray<uint8>&& BinaryData, EBA_EPayloadFormat Format, FBA_FFA_Object& Entry)
+{
+	FBA_FPayload OldPayload = MoveTemp(Entry.Payload);
+	FString OldSerializedObject = MoveTemp(Entry.SerializedObject);
+	const EBA_EPayloadFormat OldFormat = Entry.PayloadFormat;
+	Entry.Payload.Reset();
+	Entry.SerializedObject.Empty();
+	Entry.PayloadFormat = Format;
+	if (!EncodePayload(MoveTemp(BinaryData), Entry))
+	{
+		Entry.Payload = MoveTemp(OldPayload);
+		Entry.SerializedObject = MoveTemp(OldSerializedObject);
+		Entry.PayloadFormat = OldFormat;
+		return false;
+	}
+	ReleaseSharedPayload(Entry);
+	SharePayload(Entry);
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::EncodePayload(TArray<uint8>&& BinaryData, FBA_FFA_Object& Entry) const
+{
+	if (BinaryData.IsEmpty())
+	{
+		return false;
+	}
+	if (Entry.PayloadFormat == EBA_EPayloadFormat::E_Base64String)
+	{
+		Entry.SerializedObject = FBase64::Encode(BinaryData);
+		return true;
+	}
+	Entry.Payload = FBA_FPayload(MoveTemp(BinaryData));
+	Entry.Payload.Compress(PayloadSettings.CompressionCodec, PayloadSettings.CompressionThreshold);
+	// clients would fail the whole bunch, so the entry is rejected here
+	if (!Entry.Payload.FitsNetLimits())
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Payload of {size} bytes (uncompressed {raw}) exceeds the replication limit of {limit} bytes"
+			, __FUNCTION__, Entry.Payload.Num(), Entry.Payload.GetUncompressedSize(), FBA_FPayload::MaxNetPayloadSize);
+		Entry.Payload.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FBA_FFA_ObjectArray::SharePayload(FBA_FFA_Object& Entry)
+{
+	// identical payloads are stored once and referenced by id
+	if (PayloadSettings.bSharePayloads && SharedPayloadStore && !Entry.Payload.IsEmpty())
+	{
+		Entry.SharedPayloadId = SharedPayloadStore->Acquire(MoveTemp(Entry.Payload));
+		Entry.Payload.Reset();
+	}
+}
+
+UScriptStruct* FBA_FFA_ObjectArray::GetEntryStruct(const FBA_FFA_Object& Entry) const
+{
+	if (!Entry.IsStructEntry() || !ClassTable || !Entry.ClassIndex.IsValid())
+	{
+		return nullptr;
+	}
+	return ClassTable->GetStruct(Entry.ClassIndex.Get());
+}
+
+bool FBA_FFA_ObjectArray::CopyStructEntry(const FBA_FFA_Object& Entry, const UScriptStruct* StructType, void* OutStructData) const
+{
+	const UScriptStruct* EntryStruct = GetEntryStruct(Entry);
+	if (!EntryStruct || EntryStruct != StructType || !OutStructData)
+	{
+		return false;
+	}
+	TArray<uint8> Buffer;
+	const TArray<uint8>* BinaryData = GetEntryPayloadBytes(Entry, Buffer);
+	return BinaryData && BA_Statics::DeserializeStructFromBytes(*BinaryData, EntryStruct, OutStructData);
+}
+
+TSharedPtr<FStructOnScope> FBA_FFA_ObjectArray::DeserializeStructEntry(const FBA_FFA_Object& Entry) const
+{
+	UScriptStruct* EntryStruct = GetEntryStruct(Entry);
+	if (!EntryStruct)
+	{
+		return nullptr;
+	}
+	TSharedPtr<FStructOnScope> StructOnScope = MakeShared<FStructOnScope>(EntryStruct);
+	if (!CopyStructEntry(Entry, EntryStruct, StructOnScope->GetStructMemory()))
+	{
+		return nullptr;
+	}
+	return StructOnScope;
+}
+
+UClass* FBA_FFA_ObjectArray::GetEntryClass(const FBA_FFA_Object& Entry) const
+{
+	// replicated entries only carry the index into the class table
+	if (ClassTable && Entry.ClassIndex.IsValid())
+	{
+		return ClassTable->GetClass(Entry.ClassIndex.Get());
+	}
+	return Entry.ClassToCastTo;
+}
+
+const FBA_FPayload* FBA_FFA_ObjectArray::GetBinaryPayload(const FBA_FFA_Object& Entry) const
+{
+	if (Entry.SharedPayloadId == FBA_FFA_PayloadStore::InvalidPayloadId)
+	{
+		return &Entry.Payload;
+	}
+	const FBA_FPayload* SharedPayload = SharedPayloadStore ? SharedPayloadStore->Find(Entry.SharedPayloadId) : nullptr;
+	if (!SharedPayload)
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Shared payload {id} of entry '{entry}' is not available (yet)"
+			, __FUNCTION__, Entry.SharedPayloadId, Entry.InstanceGuid.ToString());
+	}
+	return SharedPayload;
+}
+
+bool FBA_FFA_ObjectArray::IsSharedPayloadPending(const FBA_FFA_Object& Entry) const
+{
+	return Entry.SharedPayloadId != FBA_FFA_PayloadStore::InvalidPayloadId
+		&& SharedPayloadStore && !SharedPayloadStore->Find(Entry.SharedPayloadId);
+}
+
+int32 FBA_FFA_ObjectArray::GetEntryPayloadSize(const FBA_FFA_Object& Entry) const
+{
+	switch (Entry.PayloadFormat)
+	{
+	case EBA_EPayloadFormat::E_Base64String:
+		return Entry.SerializedObject.Len();
+	case EBA_EPayloadFormat::E_Binary:
+	case EBA_EPayloadFormat::E_DefaultsDelta:
+	{
+		const FBA_FPayload* BinaryPayload = GetBinaryPayload(Entry);
+		return BinaryPayload ? BinaryPayload->Num() : 0;
+	}
+	default:
+		return 0;
+	}
+}
+
+const TArray<uint8>* FBA_FFA_ObjectArray::GetEntryPayloadBytes(const FBA_FFA_Object& Entry, TArray<uint8>& Buffer) const
+{
+	switch (Entry.PayloadFormat)
+	{
+	case EBA_EPayloadFormat::E_Base64String:
+		if (FBase64::Decode(Entry.SerializedObject, Buffer))
+		{
+			return &Buffer;
+		}
+		return nullptr;
+	case EBA_EPayloadFormat::E_Binary:
+	case EBA_EPayloadFormat::E_DefaultsDelta:
+	{
+		const FBA_FPayload* BinaryPayload = GetBinaryPayload(Entry);
+		return BinaryPayload ? BinaryPayload->GetUncompressedData(Buffer) : nullptr;
+	}
+	default:
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Entry '{entry}' has no valid payload format"
+			, __FUNCTION__, Entry.InstanceGuid.ToString());
+		return nullptr;
+	}
+}
+
+UObject* FBA_FFA_ObjectArray::DeserializeEntry(const FBA_FFA_Object& Entry, UObject* Outer) const
+{
+	TArray<uint8> Buffer;
+	if (const TArray<uint8>* BinaryData = GetEntryPayloadBytes(Entry, Buffer);
+		BinaryData)
+	{
+		UObject* DeserializedObject = Entry.PayloadFormat == EBA_EPayloadFormat::E_DefaultsDelta
+			? BA_Statics::DeserializeObjectDeltaToDefaults(*BinaryData, Outer, GetEntryClass(Entry))
+			: BA_Statics::DeserializeObjectFromBytes(*BinaryData, Outer, GetEntryClass(Entry));
+		if (DeserializedObject)
+		{
+			ApplyPropertyPatch(Entry, DeserializedObject, 0);
+			return DeserializedObject;
+		}
+	}
+	return nullptr;
+}
+
+bool FBA_FFA_ObjectArray::ApplyPropertyPatch(const FBA_FFA_Object& Entry, UObject* TargetObject, int32 SinceRevision) const
+{
+	if (!TargetObject || TargetObject->GetClass() != GetEntryClass(Entry))
+	{
+		return false;
+	}
+	const TArray<FProperty*>& PropertyTable = BA_Statics::GetPropertyTable(GetEntryClass(Entry));
+	bool bResult = true;
+	for (const FBA_FPropertyValue& PropertyValue : Entry.PropertyPatch.GetValues())
+	{
+		if (PropertyValue.Revision <= SinceRevision)
+		{
+			continue;
+		}
+		if (!PropertyTable.IsValidIndex(PropertyValue.PropertyIndex))
+		{
+			UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Property index {index} is not valid for class '{class}'"
+				, __FUNCTION__, PropertyValue.PropertyIndex, GetEntryClass(Entry)->GetName());
+			bResult = false;
+			continue;
+		}
+		bResult &= BA_Statics::ReadPropertyValue(PropertyTable[PropertyValue.PropertyIndex], TargetObject, PropertyValue.Value);
+	}
+	return bResult;
+}
+
+bool FBA_FFA_ObjectArray::RefreshObject(const FBA_FFA_Object& Entry, UObject* TargetObject, int32 KnownPayloadRevision, int32 KnownPatchRevision) const
+{
+	if (!TargetObject || TargetObject->GetClass() != GetEntryClass(Entry))
+	{
+		return false;
+	}
+	// same base payload - only apply the property values changed since the known patch revision
+	if (KnownPayloadRevision == Entry.PayloadRevision)
+	{
+		return ApplyPropertyPatch(Entry, TargetObject, KnownPatchRevision);
+	}
+	// payload was replaced - reload the existing object in place
+	TArray<uint8> Buffer;
+	const TArray<uint8>* BinaryData = GetEntryPayloadBytes(Entry, Buffer);
+	const bool bReloaded = BinaryData && (Entry.PayloadFormat == EBA_EPayloadFormat::E_DefaultsDelta
+		? BA_Statics::ApplyObjectDeltaToDefaults(*BinaryData, TargetObject, true)
+		: BA_Statics::DeserializeObjectInPlace(*BinaryData, TargetObject));
+	if (bReloaded)
+	{
+		return ApplyPropertyPatch(Entry, TargetObject, 0);
+	}
+	return false;
+}
+
+int32 FBA_FFA_ObjectArray::MigratePayloadFormat(EBA_EPayloadFormat NewFormat)
+{
+	PayloadSettings.Format = NewFormat;
+	int32 MigratedCount = 0;
+	for (FBA_FFA_Object& Entry : Items)
+	{
+		// struct entries are always stored as binary payload
+		if (Entry.PayloadFormat == NewFormat || !Entry.HasPayload() || Entry.IsStructEntry())
+		{
+			continue;
+		}
+		if (Entry.PayloadFormat == EBA_EPayloadFormat::E_DefaultsDelta || NewFormat == EBA_EPayloadFormat::E_DefaultsDelta
+			|| Entry.SharedPayloadId != FBA_FFA_PayloadStore::InvalidPayloadId)
+		{
+			// the defaults delta and shared payloads can only be produced from / turned into the object itself
+			UObject* StorageObject = DeserializeEntry(Entry, Owner);
+			if (!StorageObject || !WriteEntryPayload(StorageObject, Entry))
+			{
+				UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Entry '{entry}' cannot be migrated"
+					, __FUNCTION__, Entry.ToString());
+				continue;
+			}
+			Entry.PropertyPatch.Reset();
+			Entry.PayloadRevision++;
+		}
+		else if (Entry.ConvertPayloadFormat(NewFormat))
+		{
+			if (NewFormat == EBA_EPayloadFormat::E_Binary)
+			{
+				Entry.Payload.Compress(PayloadSettings.CompressionCodec, PayloadSettings.CompressionThreshold);
+			}
+		}
+		else
+		{
+			continue;
+		}
+		MarkItemDirty(Entry);
+		MigratedCount++;
+	}
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Migrated {count} of {items} entries to payload format '{format}'"
+		, __FUNCTION__, MigratedCount, Items.Num(), StaticEnum<EBA_EPayloadFormat>()->GetNameStringByValue(static_cast<int64>(NewFormat)));
+	return MigratedCount;
+}
+
+void FBA_FFA_ObjectArray::Clear()
+{
+	//for (FBA_FFA_Object Item : Items)
+	//{
+	//	if (CheckForSubobjectListSupport(Item))
+	//	{
+	//		Owner->RemoveReplicatedSubObject(Item.ObjectPtr);
+	//	}
+	//}
+	Items.Empty();
+	if (SharedPayloadStore)
+	{
+		SharedPayloadStore->Clear();
+	}
+	if (ClassTable)
+	{
+		ClassTable->Clear();
+	}
+	// handles issued before stay stale
+	EntrySlots.Reset();
+	GuidToHandle.Empty();
+	IdentifierToHandle.Empty();
+	PendingRemovals.Empty();
+	PendingSharedPayloadEntries.Empty();
+	// views and indexes keep their definition
+	for (TPair<FName, FBA_FSortedView>& View : SortedViews)
+	{
+		View.Value.Clear();
+	}
+	for (TPair<FName, FBA_FPropertyIndex>& Index : PropertyIndexes)
+	{
+		Index.Value.Clear();
+	}
+	for (TPair<FName, FBA_FRangeIndex>& Index : RangeIndexes)
+	{
+		Index.Value.Clear();
+	}
+	for (TPair<FName, FBA_FFilteredView>& View : FilteredViews)
+	{
+		View.Value.Clear();
+	}
+	NumericColumns.Clear();
+	EntryObjectsPropertyMap.Empty();
+
+	MarkArrayDirty();
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: FFA Array cleared - Items count = {items}, guid count = {guid}"
+		, __FUNCTION__, FString::FromInt(Items.Num()), FString::FromInt(GuidToHandle.Num()));
+}
+
+void FBA_FFA_ObjectArray::SortByIndex()
+{
+	// sorting by Index
+	Items.Sort();
+	RelinkEntries();
+}
+
+void FBA_FFA_ObjectArray::SortByPropertyName(const FString PropertyName, TArray<FString> SortableTypesArray)
+{
+	TArray<FBA_FSortKey> SortKeys;
+	BuildSortKeyColumn(FName(*PropertyName), SortableTypesArray, SortKeys);
+
+	// sort positions by their key, then move every entry once
+	TArray<int32> SortedPositions;
+	SortedPositions.Reserve(Items.Num());
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		SortedPositions.Add(Position);
+	}
+	Algo::StableSort(SortedPositions, [&SortKeys](int32 PositionA, int32 PositionB)
+		{
+			return SortKeys[PositionA] < SortKeys[PositionB];
+		});
+
+	TArray<FBA_FFA_Object> SortedItems;
+	SortedItems.Reserve(Items.Num());
+	for (const int32 Position : SortedPositions)
+	{
+		SortedItems.Add(MoveTemp(Items[Position]));
+	}
+	Items = MoveTemp(SortedItems);
+	RelinkEntries();
+
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: {count} entries sorted by '{property}'"
+		, __FUNCTION__, Items.Num(), PropertyName);
+}
+
+void FBA_FFA_ObjectArray::BuildSortKeyColumn(FName PropertyName, const TArray<FString>& SortableTypes, TArray<FBA_FSortKey>& OutSortKeys) const
+{
+	OutSortKeys.Reset(Items.Num());
+	// numeric properties are read from their column instead of the payload
+	const FBA_FNumericColumn* Column = GetNumericColumn(PropertyName);
+	// property lookup and type check once per class
+	TMap<const UStruct*, const FProperty*> PropertyByType;
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		const FBA_FFA_Object& Entry = Items[Position];
+		const UStruct* EntryType = GetEntryType(Entry);
+		const FProperty* Property = nullptr;
+		if (const FProperty** PropertyPtr = PropertyByType.Find(EntryType))
+		{
+			Property = *PropertyPtr;
+		}
+		else
+		{
+			Property = FindSortProperty(EntryType, PropertyName, SortableTypes);
+			PropertyByType.Add(EntryType, Property);
+		}
+		if (Column && Property && Property->IsA<FNumericProperty>())
+		{
+			const int32 Row = EntrySlots.GetHandle(Position).GetSlot();
+			OutSortKeys.Add(Column->IsSet(Row) ? FBA_FSortKey::FromNumber(Column->GetDouble(Row)) : FBA_FSortKey());
+			continue;
+		}
+		OutSortKeys.Add(ReadSortKey(Entry, Property));
+	}
+}
+
+const UStruct* FBA_FFA_ObjectArray::GetEntryType(const FBA_FFA_Object& Entry) const
+{
+	return Entry.IsStructEntry()
+		? static_cast<const UStruct*>(GetEntryStruct(Entry))
+		: static_cast<const UStruct*>(GetEntryClass(Entry));
+}
+
+const FProperty* FBA_FFA_ObjectArray::FindSortProperty(const UStruct* EntryType, FName PropertyName, const TArray<FString>& SortableTypes)
+{
+	const FProperty* Property = EntryType ? EntryType->FindPropertyByName(PropertyName) : nullptr;
+	return Property && SortableTypes.Contains(Property->GetCPPType()) ? Property : nullptr;
+}
+
+FBA_FSortKey FBA_FFA_ObjectArray::ReadSortKey(const FBA_FFA_Object& Entry, const FProperty* Property) const
+{
+	if (!Property)
+	{
+		return FBA_FSortKey();
+	}
+	if (Entry.IsStructEntry())
+	{
+		TSharedPtr<FStructOnScope> EntryStruct = DeserializeStructEntry(Entry);
+		return FBA_FSortKey::FromProperty(Property, EntryStruct.IsValid() ? EntryStruct->GetStructMemory() : nullptr);
+	}
+	return FBA_FSortKey::FromProperty(Property, DeserializeEntry(Entry, Owner));
+}
+
+#pragma region Sorted Views
+
+bool FBA_FFA_ObjectArray::CreateSortedView(FName ViewName, FName PropertyName, bool bDescending, const TArray<FString>& SortableTypes)
+{
+	if (ViewName.IsNone())
+	{
+		return false;
+	}
+	FBA_FSortedView& View = SortedViews.Add(ViewName, FBA_FSortedView(PropertyName, bDescending, SortableTypes));
+	BuildSortedView(View);
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Sorted view '{view}' created with {count} entries"
+		, __FUNCTION__, ViewName, View.Num());
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::RemoveSortedView(FName ViewName)
+{
+	return SortedViews.Remove(ViewName) > 0;
+}
+
+const FBA_FSortedView* FBA_FFA_ObjectArray::FindSortedView(FName ViewName) const
+{
+	return SortedViews.Find(ViewName);
+}
+
+void FBA_FFA_ObjectArray::BuildSortedView(FBA_FSortedView& View) const
+{
+	TArray<FBA_FSortKey> SortKeys;
+	if (!View.SortsByIndex())
+	{
+		BuildSortKeyColumn(View.GetPropertyName(), View.GetSortableTypes(), SortKeys);
+	}
+	TArray<TPair<FBA_FEntryHandle, FBA_FSortKey>> ViewEntries;
+	ViewEntries.Reserve(Items.Num());
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		ViewEntries.Emplace(EntrySlots.GetHandle(Position)
+			, View.SortsByIndex() ? FBA_FSortKey::FromNumber(Items[Position].SortIndex) : MoveTemp(SortKeys[Position]));
+	}
+	View.Reset(MoveTemp(ViewEntries));
+}
+
+#pragma endregion
+
+#pragma region Property Indexes
+
+bool FBA_FFA_ObjectArray::CreatePropertyIndex(FName PropertyName)
+{
+	if (PropertyName.IsNone())
+	{
+		return false;
+	}
+	if (PropertyIndexes.Contains(PropertyName))
+	{
+		return true;
+	}
+	FBA_FPropertyIndex& Index = PropertyIndexes.Add(PropertyName, FBA_FPropertyIndex(PropertyName));
+	BuildPropertyIndex(Index);
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Property index '{property}' created with {count} entries and {keys} values"
+		, __FUNCTION__, PropertyName, Index.Num(), Index.NumKeys());
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::RemovePropertyIndex(FName PropertyName)
+{
+	return PropertyIndexes.Remove(PropertyName) > 0;
+}
+
+const FBA_FPropertyIndex* FBA_FFA_ObjectArray::FindPropertyIndex(FName PropertyName) const
+{
+	return PropertyIndexes.Find(PropertyName);
+}
+
+void FBA_FFA_ObjectArray::BuildPropertyIndex(FBA_FPropertyIndex& Index) const
+{
+	TArray<TPair<FBA_FEntryHandle, FBA_FSortKey>> IndexEntries;
+	IndexEntries.Reserve(Items.Num());
+	ForEachPropertyValue(
+		[&Index](const UStruct* EntryType)
+		{
+			return EntryType->FindPropertyByName(Index.GetPropertyName());
+		},
+		[this, &IndexEntries](int32 Position, const FProperty* Property, const void* Container)
+		{
+			IndexEntries.Emplace(EntrySlots.GetHandle(Position), FBA_FSortKey::FromPropertyValue(Property, Container));
+		});
+	Index.Reset(MoveTemp(IndexEntries));
+}
+
+void FBA_FFA_ObjectArray::ForEachPropertyValue(const TFunctionRef<const FProperty*(const UStruct*)>& FindProperty
+	, const TFunctionRef<void(int32, const FProperty*, const void*)>& Func) const
+{
+	// property lookup once per class, entries without the property are not deserialized
+	TMap<const UStruct*, const FProperty*> PropertyByType;
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		const FBA_FFA_Object& Entry = Items[Position];
+		const UStruct* EntryType = GetEntryType(Entry);
+		const FProperty* Property = nullptr;
+		if (const FProperty** PropertyPtr = PropertyByType.Find(EntryType))
+		{
+			Property = *PropertyPtr;
+		}
+		else
+		{
+			Property = EntryType ? FindProperty(EntryType) : nullptr;
+			PropertyByType.Add(EntryType, Property);
+		}
+		if (!Property)
+		{
+			continue;
+		}
+		if (Entry.IsStructEntry())
+		{
+			TSharedPtr<FStructOnScope> EntryStruct = DeserializeStructEntry(Entry);
+			if (EntryStruct.IsValid())
+			{
+				Func(Position, Property, EntryStruct->GetStructMemory());
+			}
+		}
+		else if (const UObject* EntryObject = DeserializeEntry(Entry, Owner))
+		{
+			Func(Position, Property, EntryObject);
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region Range Indexes
+
+bool FBA_FFA_ObjectArray::CreateRangeIndex(FName PropertyName)
+{
+	if (PropertyName.IsNone())
+	{
+		return false;
+	}
+	if (RangeIndexes.Contains(PropertyName))
+	{
+		return true;
+	}
+	FBA_FRangeIndex& Index = RangeIndexes.Add(PropertyName, FBA_FRangeIndex(PropertyName));
+	BuildRangeIndex(Index);
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Range index '{property}' created with {count} entries"
+		, __FUNCTION__, PropertyName, Index.Num());
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::RemoveRangeIndex(FName PropertyName)
+{
+	return RangeIndexes.Remove(PropertyName) > 0;
+}
+
+const FBA_FRangeIndex* FBA_FFA_ObjectArray::FindRangeIndex(FName PropertyName) const
+{
+	return RangeIndexes.Find(PropertyName);
+}
+
+void FBA_FFA_ObjectArray::BuildRangeIndex(FBA_FRangeIndex& Index) const
+{
+	TArray<FBA_FRangeIndex::FEntry> IndexEntries;
+	IndexEntries.Reserve(Items.Num());
+	if (bNumericColumns)
+	{
+		// the column holds exactly the numeric values of the property
+		if (const FBA_FNumericColumn* Column = NumericColumns.FindColumn(Index.GetPropertyName()))
+		{
+			for (int32 Position = 0; Position < Items.Num(); Position++)
+			{
+				const FBA_FEntryHandle Handle = EntrySlots.GetHandle(Position);
+				if (Column->IsSet(Handle.GetSlot()) && !FMath::IsNaN(Column->GetDouble(Handle.GetSlot())))
+				{
+					IndexEntries.Add(FBA_FRangeIndex::FEntry{ Column->GetDouble(Handle.GetSlot()), Handle });
+				}
+			}
+		}
+		Index.Reset(MoveTemp(IndexEntries));
+		return;
+	}
+	ForEachPropertyValue(
+		[&Index](const UStruct* EntryType)
+		{
+			return FindRangeProperty(EntryType, Index.GetPropertyName());
+		},
+		[this, &IndexEntries](int32 Position, const FProperty* Property, const void* Container)
+		{
+			if (double Value;
+				ReadRangeValue(Property, Container, Value))
+			{
+				IndexEntries.Add(FBA_FRangeIndex::FEntry{ Value, EntrySlots.GetHandle(Position) });
+			}
+		});
+	Index.Reset(MoveTemp(IndexEntries));
+}
+
+const FProperty* FBA_FFA_ObjectArray::FindRangeProperty(const UStruct* EntryType, FName PropertyName)
+{
+	// the numeric properties the statistics are calculated for
+	const FProperty* Property = EntryType ? EntryType->FindPropertyByName(PropertyName) : nullptr;
+	return Property && Property->IsA<FNumericProperty>() ? Property : nullptr;
+}
+
+bool FBA_FFA_ObjectArray::ReadRangeValue(const FProperty* Property, const void* Container, double& OutValue)
+{
+	const FBA_FSortKey Key = FBA_FSortKey::FromProperty(Property, Container);
+	// NaN has no place in the order
+	if (Key.GetType() != FBA_FSortKey::EType::Numeric || FMath::IsNaN(Key.GetNumber()))
+	{
+		return false;
+	}
+	OutValue = Key.GetNumber();
+	return true;
+}
+
+#pragma endregion
+
+#pragma region Filtered Views
+
+bool FBA_FFA_ObjectArray::CreateFilteredView(FName ViewName, const FBA_FQuery& Query)
+{
+	if (ViewName.IsNone())
+	{
+		return false;
+	}
+	FBA_FFilteredView& View = FilteredViews.Add(ViewName, FBA_FFilteredView(Query));
+	BuildFilteredView(View);
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Filtered view '{view}' created, {visible} of {count} entries visible"
+		, __FUNCTION__, ViewName, View.NumVisible(), View.Num());
+	return true;
+}
+
+bool FBA_FFA_ObjectArray::RemoveFilteredView(FName ViewName)
+{
+	return FilteredViews.Remove(ViewName) > 0;
+}
+
+const FBA_FFilteredView* FBA_FFA_ObjectArray::FindFilteredView(FName ViewName) const
+{
+	return FilteredViews.Find(ViewName);
+}
+
+void FBA_FFA_ObjectArray::ResetTypeCaches()
+{
+	for (TPair<FName, FBA_FFilteredView>& View : FilteredViews)
+	{
+		View.Value.ResetPlans();
+	}
+	NumericColumns.ResetTypeCache();
+}
+
+void FBA_FFA_ObjectArray::BuildFilteredView(FBA_FFilteredView& View) const
+{
+	View.Clear();
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		const FBA_FFA_Object& Entry = Items[Position];
+		const FBA_FQueryPlan& Plan = View.GetPlan(GetEntryType(Entry));
+		// entries are only deserialized if a predicate reads a property
+		TSharedPtr<FStructOnScope> EntryStruct;
+		const bool bVisible = Plan.Matches([this, &Entry, &EntryStruct]() -> const void*
+			{
+				if (Entry.IsStructEntry())
+				{
+					EntryStruct = DeserializeStructEntry(Entry);
+					return EntryStruct.IsValid() ? EntryStruct->GetStructMemory() : nullptr;
+				}
+				return DeserializeEntry(Entry, Owner);
+			});
+		View.SetStatus(EntrySlots.GetHandle(Position), bVisible);
+	}
+}
+
+#pragma endregion
+
+#pragma region Paging
+
+bool FBA_FFA_ObjectArray::GetViewPage(FName ViewName, int32 Offset, int32 Count, const FBA_FEntryHandle& After, bool bSlotOrder, TArray<FBA_FEntryHandle>& OutHandles, int32& OutTotal) const
+{
+	OutHandles.Reset();
+	OutTotal = 0;
+	Offset = FMath::Max(Offset, 0);
+	Count = FMath::Max(Count, 0);
+
+	// the slot of After is a stable position even if its entry was removed, slots freed and reused in front of it are not revisited
+	auto PageInSlotOrder = [this, Offset, Count, &After, &OutHandles](TFunctionRef<bool(const FBA_FEntryHandle&)> IsInView)
+		{
+			int32 Slot = After.IsSet() ? After.GetSlot() + 1 : 0;
+			int32 Skip = After.IsSet() ? 0 : Offset;
+			for (; Slot < EntrySlots.NumSlots() && OutHandles.Num() < Count; Slot++)
+			{
+				const FBA_FEntryHandle Handle = EntrySlots.GetSlotHandle(Slot);
+				if (!Handle.IsSet() || !IsInView(Handle))
+				{
+					continue;
+				}
+				if (Skip > 0)
+				{
+					Skip--;
+					continue;
+				}
+				OutHandles.Add(Handle);
+			}
+		};
+
+	if (ViewName.IsNone())
+	{
+		OutTotal = Items.Num();
+		if (bSlotOrder)
+		{
+			PageInSlotOrder([](const FBA_FEntryHandle&) { return true; });
+			return true;
+		}
+		if (const int32 AfterPosition = After.IsSet() ? EntrySlots.Find(After) : INDEX_NONE;
+			AfterPosition != INDEX_NONE)
+		{
+			Offset = AfterPosition + 1;
+		}
+		const int32 Last = FMath::Min(Offset + Count, Items.Num());
+		OutHandles.Reserve(FMath::Max(Last - Offset, 0));
+		for (int32 Position = Offset; Position < Last; Position++)
+		{
+			OutHandles.Add(EntrySlots.GetHandle(Position));
+		}
+		return true;
+	}
+
+	if (const FBA_FSortedView* View = SortedViews.Find(ViewName))
 	{
-		return bReturn;
+		OutTotal = View->Num();
+		if (const int32 AfterIndex = After.IsSet() ? View->IndexOf(After) : INDEX_NONE;
+			AfterIndex != INDEX_NONE)
+		{
+			Offset = AfterIndex + 1;
+		}
+		const TArray<FBA_FEntryHandle>& Handles = View->GetHandles();
+		const int32 Last = FMath::Min(Offset + Count, Handles.Num());
+		if (Last > Offset)
+		{
+			OutHandles.Append(Handles.GetData() + Offset, Last - Offset);
+		}
+		return true;
 	}
-	FString Serialized = BA_Statics::SerializeObject(StorageObject);
-	FBA_FFA_Object Entry = FBA_FFA_Object(InstanceGuid, Serialized, StorageObject->GetClass());
-	if (!ReadableIdentifier.IsEmpty())
+
+	if (const FBA_FFilteredView* View = FilteredViews.Find(ViewName))
 	{
-		Entry.InstanceIdentifier = ReadableIdentifier;
+		OutTotal = View->NumVisible();
+		if (bSlotOrder)
+		{
+			PageInSlotOrder([View](const FBA_FEntryHandle& Handle) { return View->IsVisible(Handle); });
+			return true;
+		}
+		// visible entries in array order, continuing after the anchor avoids counting the skipped ones
+		int32 Position = 0;
+		int32 Skip = Offset;
+		if (const int32 AfterPosition = After.IsSet() ? EntrySlots.Find(After) : INDEX_NONE;
+			AfterPosition != INDEX_NONE && View->IsVisible(After))
+		{
+			Position = AfterPosition + 1;
+			Skip = 0;
+		}
+		for (; Position < Items.Num() && OutHandles.Num() < Count; Position++)
+		{
+			const FBA_FEntryHandle Handle = EntrySlots.GetHandle(Position);
+			if (!View->IsVisible(Handle))
+			{
+				continue;
+			}
+			if (Skip > 0)
+			{
+				Skip--;
+				continue;
+			}
+			OutHandles.Add(Handle);
+		}
+		return true;
 	}
-	
-	if (int32 Position = Items.Add(MoveTemp(Entry));
-		Position != INDEX_NONE)
+	return false;
+}
+
+#pragma endregion
+
+#pragma region Numeric Columns
+
+void FBA_FFA_ObjectArray::SetNumericColumns(bool bEnabled)
+{
+	if (bNumericColumns == bEnabled)
 	{
-		// save position in map for easier access
-		Items[Position].SortIndex = Position;
-		//Entry.SortIndex = Position;
-		GuidToArrayPos.Add(Items[Position].InstanceGuid, Position);
-		IdentifierToArrayPos.Add(Items[Position].InstanceIdentifier, Position);
-		// register with owner
-		/*if (CheckForSubobjectListSupport(Items[Position]))
-		{
-			Owner->AddReplicatedSubObject(Items[Position].ObjectPtr);
-		}*/
-		// update item
-		MarkItemDirty(Items[Position]);
-		bReturn = true;
-		UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Entry '{entry}' newly added to array at position {position}"
-			, __FUNCTION__, Items[Position].ToString(), FString::FromInt(Position));
+		return;
 	}
-	else
+	bNumericColumns = bEnabled;
+	NumericColumns.Clear();
+	if (!bEnabled)
 	{
-		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Error adding Entry '{entry}' to array"
-			, __FUNCTION__, Entry.ToString());
+		return;
 	}
-
-	return bReturn;
+	ForEachPropertyValue(
+		[](const UStruct* EntryType) -> const FProperty*
+		{
+			// any property, every entry needs a row
+			return EntryType->PropertyLink;
+		},
+		[this](int32 Position, const FProperty* Property, const void* Container)
+		{
+			NumericColumns.SetRow(EntrySlots.GetHandle(Position).GetSlot(), GetEntryType(Items[Position]), Container);
+		});
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Numeric columns built for {count} entries, {columns} columns"
+		, __FUNCTION__, Items.Num(), NumericColumns.GetColumns().Num());
 }
 
-void FBA_FFA_ObjectArray::Clear()
+const FBA_FNumericColumn* FBA_FFA_ObjectArray::GetNumericColumn(FName PropertyName) const
 {
-	//for (FBA_FFA_Object Item : Items)
-	//{
-	//	if (CheckForSubobjectListSupport(Item))
-	//	{
-	//		Owner->RemoveReplicatedSubObject(Item.ObjectPtr);
-	//	}
-	//}
-	Items.Empty();
-	GuidToArrayPos.Empty();
-	IdentifierToArrayPos.Empty();
-	EntryObjectsPropertyMap.Empty();
-
-	MarkArrayDirty();
-	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: FFA Array cleared - Items count = {items}, guid count = {guid}"
-		, __FUNCTION__, FString::FromInt(Items.Num()), FString::FromInt(GuidToArrayPos.Num()));
+	return bNumericColumns ? NumericColumns.FindColumn(PropertyName) : nullptr;
 }
 
-void FBA_FFA_ObjectArray::SortByIndex()
+namespace
 {
-	// sorting by Index
-	Items.Sort();
-	GuidToArrayPos.Empty(Items.Num());
-	IdentifierToArrayPos.Empty(Items.Num());
-	for (int32 i = 0; i < Items.Num(); i++)
+	template<typename ValueType>
+	void RunAggregate(const ValueType* Values, const TBitArray<>& Mask, EBA_EAggregateOp Op, double Threshold, double& OutResult, int32& OutCount)
 	{
-		GuidToArrayPos.Emplace(Items[i].InstanceGuid, i);
-		IdentifierToArrayPos.Emplace(Items[i].InstanceIdentifier, i);
+		OutResult = 0;
+		OutCount = 0;
+		switch (Op)
+		{
+		case EBA_EAggregateOp::E_Sum:
+			OutResult = FBA_FAggregateKernels::Sum(Values, Mask, OutCount);
+			break;
+		case EBA_EAggregateOp::E_Mean:
+			OutResult = FBA_FAggregateKernels::Sum(Values, Mask, OutCount);
+			OutResult = OutCount > 0 ? OutResult / OutCount : 0;
+			break;
+		case EBA_EAggregateOp::E_Min:
+		case EBA_EAggregateOp::E_Max:
+			if (double Min, Max;
+				FBA_FAggregateKernels::MinMax(Values, Mask, Min, Max))
+			{
+				OutResult = Op == EBA_EAggregateOp::E_Min ? Min : Max;
+				OutCount = Mask.CountSetBits();
+			}
+			break;
+		case EBA_EAggregateOp::E_Count:
+			OutCount = Mask.CountSetBits();
+			OutResult = OutCount;
+			break;
+		case EBA_EAggregateOp::E_CountAbove:
+			OutCount = Mask.CountSetBits();
+			OutResult = FBA_FAggregateKernels::CountAbove(Values, Mask, Threshold);
+			break;
+		default:
+			break;
+		}
 	}
 }
 
-void FBA_FFA_ObjectArray::SortByPropertyName(const FString PropertyName, TArray<FString> SortableTypesArray)
+bool FBA_FFA_ObjectArray::Aggregate(FName PropertyName, EBA_EAggregateOp Op, FName FilterViewName, double Threshold, double& OutResult, int32& OutCount) const
 {
-	//TLess<> Predicate;
-	auto SortAlgorithm = [PropertyName, SortableTypesArray, this](FBA_FFA_Object EntryA, FBA_FFA_Object EntryB)
+	OutResult = 0;
+	OutCount = 0;
+	const FBA_FFilteredView* Filter = FilterViewName.IsNone() ? nullptr : FilteredViews.Find(FilterViewName);
+	if (!FilterViewName.IsNone() && !Filter)
+	{
+		return false;
+	}
+
+	if (bNumericColumns)
+	{
+		const FBA_FNumericColumn* Column = NumericColumns.FindColumn(PropertyName);
+		if (!Column)
+		{
+			// no entry has the property
+			return true;
+		}
+		// only a filter needs its own mask, the unfiltered scan reads the column bitmap in place
+		TBitArray<> FilteredMask;
+		if (Filter)
 		{
-			// ToDo - owner??
-			UObject* UObjectA = BA_Statics::DeserializeObjectFromString(EntryA.SerializedObject, Owner, EntryA.ClassToCastTo);
-			UObject* UObjectB = BA_Statics::DeserializeObjectFromString(EntryB.SerializedObject, Owner, EntryB.ClassToCastTo);
+			FilteredMask = TBitArray<>::BitwiseAND(Column->GetPresent(), Filter->GetVisibleSlots(), EBitwiseOperatorFlags::MinSize);
+		}
+		const TBitArray<>& Mask = Filter ? FilteredMask : Column->GetPresent();
+		if (Column->IsInteger())
+		{
+			RunAggregate(Column->GetIntegers().GetData(), Mask, Op, Threshold, OutResult, OutCount);
+		}
+		else
+		{
+			RunAggregate(Column->GetDoubles().GetData(), Mask, Op, Threshold, OutResult, OutCount);
+		}
+		return true;
+	}
 
-			if (UObjectA == NULL || UObjectB == NULL)
+	// without columns the values are gathered from the entries first
+	TArray<double> Values;
+	ForEachPropertyValue(
+		[PropertyName](const UStruct* EntryType)
+		{
+			return FindRangeProperty(EntryType, PropertyName);
+		},
+		[this, Filter, &Values](int32 Position, const FProperty* Property, const void* Container)
+		{
+			if (double Value;
+				(!Filter || Filter->IsVisible(EntrySlots.GetHandle(Position))) && ReadRangeValue(Property, Container, Value))
 			{
-				return false;
+				Values.Add(Value);
 			}
+		});
+	RunAggregate(Values.GetData(), TBitArray<>(true, Values.Num()), Op, Threshold, OutResult, OutCount);
+	return true;
+}
 
-			FProperty* PropA = UObjectA->GetClass()->FindPropertyByName(*PropertyName);
-			FProperty* PropB = UObjectB->GetClass()->FindPropertyByName(*PropertyName);
-
-			if (PropA == NULL || PropB == NULL)
-			{
-				return false;
-			}
+#pragma endregion
 
-			// Determine the value type of both FProperty
-			FString TypeA = PropA->GetCPPType();
-			FString TypeB = PropB->GetCPPType();
+#pragma region Secondary Index Maintenance
 
-			// Check if both types are equal
-			if (TypeA != TypeB)
-			{
-				return false;
-			}
+void FBA_FFA_ObjectArray::UpdateSecondaryIndexes(int32 Position)
+{
+	if ((SortedViews.IsEmpty() && PropertyIndexes.IsEmpty() && RangeIndexes.IsEmpty() && FilteredViews.IsEmpty() && !bNumericColumns)
+		|| !Items.IsValidIndex(Position))
+	{
+		return;
+	}
+	const FBA_FEntryHandle Handle = EntrySlots.GetHandle(Position);
+	const FBA_FFA_Object& Entry = Items[Position];
+	const UStruct* EntryType = GetEntryType(Entry);
 
-			// Check if the type is found in the type array
-			if (!SortableTypesArray.Contains(TypeA))
+	// the entry is deserialized at most once for all views and indexes
+	TSharedPtr<FStructOnScope> EntryStruct;
+	const void* Container = nullptr;
+	bool bDeserialized = false;
+	auto GetContainer = [&]() -> const void*
+		{
+			if (!bDeserialized)
 			{
-				return false;
+				bDeserialized = true;
+				if (Entry.IsStructEntry())
+				{
+					EntryStruct = DeserializeStructEntry(Entry);
+					Container = EntryStruct.IsValid() ? EntryStruct->GetStructMemory() : nullptr;
+				}
+				else
+				{
+					Container = DeserializeEntry(Entry, Owner);
+				}
 			}
-
-			// Retrieve the value of both FProperty
-			FString ValueA, ValueB;
-			PropA->ExportText_InContainer(0, ValueA, UObjectA, UObjectA, UObjectA, PPF_None);
-			PropB->ExportText_InContainer(0, ValueB, UObjectB, UObjectB, UObjectB, PPF_None);
-
-			// Compare the values with "<" and return true or false
-			return ValueA < ValueB;
+			return Container;
 		};
 
-	Algo::Sort(Items, SortAlgorithm);
+	if (bNumericColumns)
+	{
+		NumericColumns.SetRow(Handle.GetSlot(), EntryType, GetContainer());
+	}
+	for (TPair<FName, FBA_FSortedView>& View : SortedViews)
+	{
+		if (View.Value.SortsByIndex())
+		{
+			View.Value.Update(Handle, FBA_FSortKey::FromNumber(Entry.SortIndex));
+			continue;
+		}
+		const FProperty* Property = FindSortProperty(EntryType, View.Value.GetPropertyName(), View.Value.GetSortableTypes());
+		View.Value.Update(Handle, Property ? FBA_FSortKey::FromProperty(Property, GetContainer()) : FBA_FSortKey());
+	}
+	for (TPair<FName, FBA_FPropertyIndex>& Index : PropertyIndexes)
+	{
+		const FProperty* Property = EntryType ? EntryType->FindPropertyByName(Index.Key) : nullptr;
+		Index.Value.Set(Handle, Property ? FBA_FSortKey::FromPropertyValue(Property, GetContainer()) : FBA_FSortKey());
+	}
+	for (TPair<FName, FBA_FRangeIndex>& Index : RangeIndexes)
+	{
+		const FProperty* Property = FindRangeProperty(EntryType, Index.Key);
+		if (double Value;
+			Property && ReadRangeValue(Property, GetContainer(), Value))
+		{
+			Index.Value.Set(Handle, Value);
+		}
+		else
+		{
+			Index.Value.Remove(Handle);
+		}
+	}
+	for (TPair<FName, FBA_FFilteredView>& View : FilteredViews)
+	{
+		const FBA_FQueryPlan& Plan = View.Value.GetPlan(EntryType);
+		View.Value.SetStatus(Handle, Plan.Matches(GetContainer));
+	}
 }
 
+void FBA_FFA_ObjectArray::RemoveFromSecondaryIndexes(const FBA_FEntryHandle& Handle)
+{
+	if (bNumericColumns)
+	{
+		NumericColumns.ClearRow(Handle.GetSlot());
+	}
+	for (TPair<FName, FBA_FSortedView>& View : SortedViews)
+	{
+		View.Value.Remove(Handle);
+	}
+	for (TPair<FName, FBA_FPropertyIndex>& Index : PropertyIndexes)
+	{
+		Index.Value.Remove(Handle);
+	}
+	for (TPair<FName, FBA_FRangeIndex>& Index : RangeIndexes)
+	{
+		Index.Value.Remove(Handle);
+	}
+	for (TPair<FName, FBA_FFilteredView>& View : FilteredViews)
+	{
+		View.Value.Remove(Handle);
+	}
+}
 
+#pragma endregion
 
 bool FBA_FFA_ObjectArray::RemoveEntry(FGuid InstanceGuid, UObject*& DeletedEntry)
 {
@@ -164,36 +1446,33 @@ bool FBA_FFA_ObjectArray::RemoveEntry(FGuid InstanceGuid, UObject*& DeletedEntry
 		return false;
 	}
 
-	if (int32* PositionPtr = GuidToArrayPos.Find(InstanceGuid);
-		PositionPtr
-		&& *PositionPtr != INDEX_NONE
-		&& Items.IsValidIndex(*PositionPtr))
+	if (const int32 Position = FindPosition(InstanceGuid);
+		Position != INDEX_NONE)
 	{
 		// send a copy of the deleted back
-		DeletedEntry = BA_Statics::DeserializeObjectFromString(Items[*PositionPtr].SerializedObject, Owner, Items[*PositionPtr].ClassToCastTo);
+		DeletedEntry = DeserializeEntry(Items[Position], Owner);
 		// remove from subobject list 
-		//if (CheckForSubobjectListSupport(Items[*PositionPtr]))
+		//if (CheckForSubobjectListSupport(Items[Position]))
 		//{
-		//	Owner->RemoveReplicatedSubObject(Items[*PositionPtr].ObjectPtr);
+		//	Owner->RemoveReplicatedSubObject(Items[Position].ObjectPtr);
 		//}
 		// generate log string before removing anything
 		FString LogString = "Entry '" + InstanceGuid.ToString() + "' was swapped with '" 
 			+ Items[Items.Num() - 1].ToString() + "' and removed from position " 
-			+ FString::FromInt(*PositionPtr);
-		// remove from Identifier map 
-		IdentifierToArrayPos.Remove(Items[*PositionPtr].InstanceIdentifier);
+			+ FString::FromInt(Position);
+		// remove from guid and identifier map 
+		UnindexEntry(Items[Position]);
+		// drop reference to shared payload
+		ReleaseSharedPayload(Items[Position]);
 		// push last to position to be removed
 		// not updating local var 'Index', so sorting to original order still possible
-		Items.Swap(*PositionPtr, Items.Num() - 1);
-		// updated guid map for swapped 
-		GuidToArrayPos.Add(Items[*PositionPtr].InstanceGuid, *PositionPtr);
-		IdentifierToArrayPos.Add(Items[*PositionPtr].InstanceIdentifier, *PositionPtr);
-		// remove from guid map
-		GuidToArrayPos.Remove(InstanceGuid);
+		Items.Swap(Position, Items.Num() - 1);
+		// the handle of the swapped entry stays valid, only its slot is moved
+		EntrySlots.RemoveAtSwap(Position);
 		
 		// mark item dirty
 		MarkItemDirty(Items[Items.Num() - 1]);
-		MarkItemDirty(Items[*PositionPtr]);
+		MarkItemDirty(Items[Position]);
 		// shrink array
 		Items.SetNum(Items.Num() - 1);
 
@@ -203,12 +1482,70 @@ bool FBA_FFA_ObjectArray::RemoveEntry(FGuid InstanceGuid, UObject*& DeletedEntry
 	}
 	else
 	{
-		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Guid '{guid}' cannot be found in GuidToArrayPos"
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Guid '{guid}' cannot be found in GuidToHandle"
 			, __FUNCTION__, InstanceGuid.ToString());
 	}
 	return false;
 }
 
+int32 FBA_FFA_ObjectArray::RemoveEntries(const TArray<FGuid>& InstanceGuids, TArray<FGuid>& OutRemovedGuids)
+{
+	OutRemovedGuids.Reset();
+	if (InstanceGuids.IsEmpty() || Items.IsEmpty())
+	{
+		return 0;
+	}
+
+	// flag all positions first, duplicates and unknown guids are skipped
+	TBitArray<> RemovedPositions(false, Items.Num());
+	OutRemovedGuids.Reserve(InstanceGuids.Num());
+	for (const FGuid& InstanceGuid : InstanceGuids)
+	{
+		const int32 Position = FindPosition(InstanceGuid);
+		if (Position == INDEX_NONE || RemovedPositions[Position])
+		{
+			continue;
+		}
+		FBA_FFA_Object& Entry = Items[Position];
+		RemovedPositions[Position] = true;
+		UnindexEntry(Entry);
+		ReleaseSharedPayload(Entry);
+		EntrySlots.Remove(Position);
+		OutRemovedGuids.Add(InstanceGuid);
+	}
+	const int32 RemovedCount = OutRemovedGuids.Num();
+	if (RemovedCount == 0)
+	{
+		return 0;
+	}
+
+	// fill every hole below the new size with the last surviving entry
+	const int32 NewNum = Items.Num() - RemovedCount;
+	int32 Tail = Items.Num() - 1;
+	for (int32 Hole = 0; Hole < NewNum; Hole++)
+	{
+		if (!RemovedPositions[Hole])
+		{
+			continue;
+		}
+		while (RemovedPositions[Tail])
+		{
+			Tail--;
+		}
+		Items[Hole] = MoveTemp(Items[Tail]);
+		EntrySlots.Move(Tail, Hole);
+		MarkItemDirty(Items[Hole]);
+		Tail--;
+	}
+	Items.SetNum(NewNum);
+	EntrySlots.SetNum(NewNum);
+	MarkArrayDirty();
+
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: {removed} of {count} entries removed from array"
+		, __FUNCTION__, RemovedCount, InstanceGuids.Num());
+	return RemovedCount;
+}
+
 #pragma endregion
 
 #pragma region Networking
@@ -221,9 +1558,17 @@ void FBA_FFA_ObjectArray::PreReplicatedRemove(const TArrayView<int32>& RemovedIn
 		if (!Items.IsValidIndex(Index)) { continue; }
 
 		FBA_FFA_Object& Entry = Items[Index];
-		// update helper maps
-		GuidToArrayPos.Remove(Entry.InstanceGuid);
-		IdentifierToArrayPos.Remove(Entry.InstanceIdentifier);
+		if (PendingSharedPayloadEntries.Num() > 0)
+		{
+			const FBA_FEntryHandle Handle = EntrySlots.GetHandle(Index);
+			for (auto It = PendingSharedPayloadEntries.CreateIterator(); It; ++It)
+			{
+				if (It.Value().Handle == Handle) { It.RemoveCurrent(); }
+			}
+		}
+		// update helper maps, the slot is released once the entry is removed from Items
+		UnindexEntry(Entry);
+		PendingRemovals.Add(Index);
 
 		OnEntryPreReplicatedRemove.ExecuteIfBound(Entry);
 	}
@@ -237,12 +1582,13 @@ void FBA_FFA_ObjectArray::PostReplicatedAdd(const TArrayView<int32>& AddedIndice
 		if (!Items.IsValidIndex(Index)) { continue; }
 
 		FBA_FFA_Object& Entry = Items[Index];
-		// check index map storage
-		if (int32* Position = GuidToArrayPos.Find(Entry.InstanceGuid);
-			Position && *Position == INDEX_NONE)
+		Entry.ClassToCastTo = GetEntryClass(Entry);
+		// new entries are appended, so this only extends the slot map
+		IndexEntry(Index);
+		if (IsSharedPayloadPending(Entry))
 		{
-			GuidToArrayPos.Add(Entry.InstanceGuid, Entry.SortIndex);
-			IdentifierToArrayPos.Add(Entry.InstanceIdentifier, Entry.SortIndex);
+			DeferUntilSharedPayload(Entry, true);
+			continue;
 		}
 		OnEntryPostReplicatedAdd.ExecuteIfBound(Entry);
 	}
@@ -256,12 +1602,20 @@ void FBA_FFA_ObjectArray::PostReplicatedChange(const TArrayView<int32>& ChangedI
 		if (!Items.IsValidIndex(Index)) { continue; }
 
 		FBA_FFA_Object& Entry = Items[Index];
-		// check index map storage
-		if (int32* Position = GuidToArrayPos.Find(Entry.InstanceGuid);
-			Position && *Position == INDEX_NONE)
+		Entry.ClassToCastTo = GetEntryClass(Entry);
+		// entries are always indexed by their add, only repair a missing index here
+		if (FindPosition(Entry.InstanceGuid) != Index)
+		{
+			IndexEntry(Index);
+		}
+		else
+		{
+			UpdateSecondaryIndexes(Index);
+		}
+		if (IsSharedPayloadPending(Entry))
 		{
-			GuidToArrayPos.Add(Entry.InstanceGuid, Entry.SortIndex);
-			IdentifierToArrayPos.Add(Entry.InstanceIdentifier, Entry.SortIndex);
+			DeferUntilSharedPayload(Entry, false);
+			continue;
 		}
 		OnEntryPostReplicatedChange.ExecuteIfBound(Entry);
 	}
@@ -270,11 +1624,81 @@ void FBA_FFA_ObjectArray::PostReplicatedChange(const TArrayView<int32>& ChangedI
 // called fourth after add or remove
 void FBA_FFA_ObjectArray::PostReplicatedReceive(const FBA_FFA_ObjectArray::FPostReplicatedReceiveParameters& Parameters)
 {
+	// the removed entries were deleted with RemoveAtSwap in descending index order, mirror this in the slot map
+	if (PendingRemovals.Num() > 0)
+	{
+		PendingRemovals.Sort(TGreater<int32>());
+		for (const int32 Index : PendingRemovals)
+		{
+			EntrySlots.RemoveAtSwap(Index);
+		}
+	}
+	// only positions that received an entry from the end can be out of sync
+	bool bSlotsInSync = EntrySlots.Num() == Items.Num();
+	for (int32 Index = 0; bSlotsInSync && Index < PendingRemovals.Num(); Index++)
+	{
+		const int32 Position = PendingRemovals[Index];
+		bSlotsInSync = !Items.IsValidIndex(Position) || FindPosition(Items[Position].InstanceGuid) == Position;
+	}
+	PendingRemovals.Reset();
+	if (!bSlotsInSync)
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Slot map out of sync with {count} entries, rebuilding all handles"
+			, __FUNCTION__, Items.Num());
+		RebuildEntryIndex();
+	}
 	OnEntryPostReplicatedReceive.ExecuteIfBound(Parameters.OldArraySize);
 }
 
+void FBA_FFA_ObjectArray::DeferUntilSharedPayload(const FBA_FFA_Object& Entry, bool bAdded)
+{
+	const FBA_FEntryHandle Handle = GetEntryHandle(Entry.InstanceGuid);
+	if (!Handle.IsSet()) { return; }
+
+	// an entry waits for its latest payload only, an add that is still due stays due
+	for (auto It = PendingSharedPayloadEntries.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Handle == Handle)
+		{
+			bAdded |= It.Value().bAdded;
+			It.RemoveCurrent();
+		}
+	}
+	PendingSharedPayloadEntries.Add(Entry.SharedPayloadId, { Handle, bAdded });
+	UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Entry '{entry}' waits for shared payload {id}"
+		, __FUNCTION__, Entry.InstanceGuid.ToString(), Entry.SharedPayloadId);
+}
+
+void FBA_FFA_ObjectArray::ResolveSharedPayload(int32 PayloadId)
+{
+	TArray<FPendingSharedPayloadEntry> Resolved;
+	PendingSharedPayloadEntries.MultiFind(PayloadId, Resolved);
+	if (Resolved.IsEmpty()) { return; }
+	PendingSharedPayloadEntries.Remove(PayloadId);
+
+	for (const FPendingSharedPayloadEntry& Pending : Resolved)
+	{
+		const int32 Position = EntrySlots.Find(Pending.Handle);
+		// removed entries already left the pending map, this only skips stale handles
+		if (!Items.IsValidIndex(Position) || Items[Position].SharedPayloadId != PayloadId) { continue; }
+
+		// views and indexes could not read the entry before
+		UpdateSecondaryIndexes(Position);
+		if (Pending.bAdded)
+		{
+			OnEntryPostReplicatedAdd.ExecuteIfBound(Items[Position]);
+		}
+		else
+		{
+			OnEntryPostReplicatedChange.ExecuteIfBound(Items[Position]);
+		}
+	}
+}
+
 bool FBA_FFA_ObjectArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
 {
+	// with bPropertyDeltaReplication the serializer runs with delta struct serialization enabled (see SetPropertyDeltaReplication):
+	// changed entries then only send their changed replicated fields - usually just the changed FBA_FPropertyValue elements of the patch
 	return FFastArraySerializer::FastArrayDeltaSerialize<FBA_FFA_Object, FBA_FFA_ObjectArray>(Items, DeltaParms, *this);
 }
 
@@ -302,12 +1726,10 @@ bool FBA_FFA_ObjectArray::GetEntryByGuid(FGuid Guid, FBA_FFA_Object& ResultEntry
 			, __FUNCTION__, Guid.ToString());
 		return false;
 	}
-	if (int32* PositionPtr = GuidToArrayPos.Find(Guid);
-		PositionPtr
-		&& *PositionPtr != INDEX_NONE
-		&& Items.IsValidIndex(*PositionPtr))
+	if (const int32 Position = FindPosition(Guid);
+		Position != INDEX_NONE)
 	{
-		ResultEntry = Items[*PositionPtr];
+		ResultEntry = Items[Position];
 		return true;
 	}
 	return false;
@@ -315,18 +1737,58 @@ bool FBA_FFA_ObjectArray::GetEntryByGuid(FGuid Guid, FBA_FFA_Object& ResultEntry
 
 bool FBA_FFA_ObjectArray::GetEntryByIdentifier(FString Identifier, FBA_FFA_Object& ResultEntry)
 {
-	if (!Identifier.IsEmpty())
+	if (Identifier.IsEmpty())
 	{
 		UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Identifier is empty"
 			, __FUNCTION__);
 		return false;
 	}
-	if (int32* PositionPtr = IdentifierToArrayPos.Find(Identifier);
-		PositionPtr
-		&& *PositionPtr != INDEX_NONE
-		&& Items.IsValidIndex(*PositionPtr))
+	// guid based identifiers are not indexed, their readable form is the guid itself
+	if (FGuid Guid;
+		FGuid::Parse(Identifier, Guid)
+		&& GetEntryByGuid(Guid, ResultEntry)
+		&& ResultEntry.InstanceIdentifier.IsGuidBased())
+	{
+		return true;
+	}
+	FBA_FIdentifier CompactIdentifier;
+	if (!FBA_FIdentifier::FindFromString(Identifier, CompactIdentifier))
+	{
+		return false;
+	}
+	return GetEntryByIdentifier(CompactIdentifier, ResultEntry);
+}
+
+bool FBA_FFA_ObjectArray::GetEntryByIdentifier(const FBA_FIdentifier& Identifier, FBA_FFA_Object& ResultEntry)
+{
+	if (const FBA_FEntryHandle* HandlePtr = IdentifierToHandle.Find(Identifier))
+	{
+		if (const FBA_FFA_Object* Entry = FindEntry(*HandlePtr))
+		{
+			ResultEntry = *Entry;
+			return true;
+		}
+	}
+	return false;
+}
+
+FBA_FEntryHandle FBA_FFA_ObjectArray::GetEntryHandle(const FGuid& Guid) const
+{
+	const FBA_FEntryHandle* HandlePtr = GuidToHandle.Find(Guid);
+	return HandlePtr ? *HandlePtr : FBA_FEntryHandle();
+}
+
+const FBA_FFA_Object* FBA_FFA_ObjectArray::FindEntry(const FBA_FEntryHandle& Handle) const
+{
+	const int32 Position = EntrySlots.Find(Handle);
+	return Items.IsValidIndex(Position) ? &Items[Position] : nullptr;
+}
+
+bool FBA_FFA_ObjectArray::GetEntryByHandle(const FBA_FEntryHandle& Handle, FBA_FFA_Object& ResultEntry) const
+{
+	if (const FBA_FFA_Object* Entry = FindEntry(Handle))
 	{
-		ResultEntry = Items[*PositionPtr];
+		ResultEntry = *Entry;
 		return true;
 	}
 	return false;
@@ -334,6 +1796,112 @@ bool FBA_FFA_ObjectArray::GetEntryByIdentifier(FString Identifier, FBA_FFA_Objec
 
 #pragma region Misc Helper
 
+int32 FBA_FFA_ObjectArray::FindPosition(const FGuid& Guid) const
+{
+	const FBA_FEntryHandle* HandlePtr = GuidToHandle.Find(Guid);
+	if (!HandlePtr)
+	{
+		return INDEX_NONE;
+	}
+	const int32 Position = EntrySlots.Find(*HandlePtr);
+	return Items.IsValidIndex(Position) ? Position : INDEX_NONE;
+}
+
+FBA_FEntryHandle FBA_FFA_ObjectArray::IndexEntry(int32 Position)
+{
+	const FBA_FFA_Object& Entry = Items[Position];
+	// a handle still linked to this position is replaced
+	if (const FBA_FEntryHandle OldHandle = EntrySlots.GetHandle(Position);
+		OldHandle.IsSet())
+	{
+		RemoveFromSecondaryIndexes(OldHandle);
+	}
+	const FBA_FEntryHandle Handle = EntrySlots.Add(Position);
+	GuidToHandle.Add(Entry.InstanceGuid, Handle);
+	// guid based identifiers are found through GuidToHandle
+	if (!Entry.InstanceIdentifier.IsGuidBased())
+	{
+		IdentifierToHandle.Add(Entry.InstanceIdentifier, Handle);
+	}
+	UpdateSecondaryIndexes(Position);
+	return Handle;
+}
+
+void FBA_FFA_ObjectArray::UnindexEntry(const FBA_FFA_Object& Entry)
+{
+	if (const FBA_FEntryHandle* HandlePtr = GuidToHandle.Find(Entry.InstanceGuid))
+	{
+		RemoveFromSecondaryIndexes(*HandlePtr);
+	}
+	GuidToHandle.Remove(Entry.InstanceGuid);
+	if (!Entry.InstanceIdentifier.IsGuidBased())
+	{
+		IdentifierToHandle.Remove(Entry.InstanceIdentifier);
+	}
+}
+
+void FBA_FFA_ObjectArray::RelinkEntries()
+{
+	// Items was reordered, the handles stay the same
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		const FBA_FEntryHandle* HandlePtr = GuidToHandle.Find(Items[Position].InstanceGuid);
+		if (!HandlePtr || !EntrySlots.Relink(Position, *HandlePtr))
+		{
+			IndexEntry(Position);
+		}
+	}
+}
+
+void FBA_FFA_ObjectArray::RebuildEntryIndex()
+{
+	// rows are written again by IndexEntry
+	NumericColumns.Clear();
+	EntrySlots.Reset();
+	GuidToHandle.Reset();
+	IdentifierToHandle.Reset();
+	// views and property indexes are built once after all handles exist
+	TMap<FName, FBA_FSortedView> Views = MoveTemp(SortedViews);
+	TMap<FName, FBA_FPropertyIndex> Indexes = MoveTemp(PropertyIndexes);
+	TMap<FName, FBA_FRangeIndex> Ranges = MoveTemp(RangeIndexes);
+	TMap<FName, FBA_FFilteredView> Filters = MoveTemp(FilteredViews);
+	SortedViews.Reset();
+	PropertyIndexes.Reset();
+	RangeIndexes.Reset();
+	FilteredViews.Reset();
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		IndexEntry(Position);
+	}
+	SortedViews = MoveTemp(Views);
+	PropertyIndexes = MoveTemp(Indexes);
+	RangeIndexes = MoveTemp(Ranges);
+	FilteredViews = MoveTemp(Filters);
+	for (TPair<FName, FBA_FSortedView>& View : SortedViews)
+	{
+		BuildSortedView(View.Value);
+	}
+	for (TPair<FName, FBA_FPropertyIndex>& Index : PropertyIndexes)
+	{
+		BuildPropertyIndex(Index.Value);
+	}
+	for (TPair<FName, FBA_FRangeIndex>& Index : RangeIndexes)
+	{
+		BuildRangeIndex(Index.Value);
+	}
+	for (TPair<FName, FBA_FFilteredView>& View : FilteredViews)
+	{
+		BuildFilteredView(View.Value);
+	}
+}
+
+void FBA_FFA_ObjectArray::SetPropertyDeltaReplication(bool bEnabled)
+{
+	PayloadSettings.bPropertyDeltaReplication = bEnabled;
+	// must happen before the first serialization of the array
+	SetDeltaSerializationEnabled(bEnabled);
+}
+
 bool FBA_FFA_ObjectArray::CheckForSubobjectListSupport(FBA_FFA_Object& Entry)
 {
 	if (!Owner)
@@ -349,7 +1917,7 @@ bool FBA_FFA_ObjectArray::CheckForSubobjectListSupport(FBA_FFA_Object& Entry)
 		return false;
 	}
 	//if (!IsValid(Entry.ObjectPtr))
-	if (Entry.SerializedObject.IsEmpty())
+	if (!Entry.HasPayload())
 	{
 		return false;
 	}
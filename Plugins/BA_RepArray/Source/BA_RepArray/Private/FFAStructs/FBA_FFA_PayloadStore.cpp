@@ -0,0 +1,153 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FFA_PayloadStore.h"
+#include "Hash/CityHash.h"
+#include "Logging/StructuredLog.h"
+#include "BA_RepArray.h"
+
+#pragma region Payload References
+
+int32 FBA_FFA_PayloadStore::Acquire(FBA_FPayload&& Payload)
+{
+	if (Payload.IsEmpty())
+	{
+		return InvalidPayloadId;
+	}
+	const uint64 ContentHash = CityHash64WithSeed(reinterpret_cast<const char*>(Payload.GetData().GetData()), Payload.Num(), static_cast<uint64>(Payload.GetCodec()));
+
+	// compare content as well, hash collisions just result in a second payload
+	TArray<int32> Candidates;
+	ContentHashToPayloadId.MultiFind(ContentHash, Candidates);
+	for (int32 PayloadId : Candidates)
+	{
+		if (const int32* PositionPtr = PayloadIdToArrayPos.Find(PayloadId);
+			PositionPtr && Items[*PositionPtr].Payload == Payload)
+		{
+			Items[*PositionPtr].ReferenceCount++;
+			return PayloadId;
+		}
+	}
+
+	FBA_FFA_SharedPayload& SharedPayload = Items.AddDefaulted_GetRef();
+	SharedPayload.PayloadId = NextPayloadId++;
+	SharedPayload.Payload = MoveTemp(Payload);
+	SharedPayload.ContentHash = ContentHash;
+	SharedPayload.ReferenceCount = 1;
+	PayloadIdToArrayPos.Add(SharedPayload.PayloadId, Items.Num() - 1);
+	ContentHashToPayloadId.Add(ContentHash, SharedPayload.PayloadId);
+	MarkItemDirty(SharedPayload);
+
+	UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Stored shared payload {id} with {size} bytes"
+		, __FUNCTION__, SharedPayload.PayloadId, SharedPayload.Payload.Num());
+	return SharedPayload.PayloadId;
+}
+
+void FBA_FFA_PayloadStore::AddReference(int32 PayloadId)
+{
+	if (const int32* PositionPtr = PayloadIdToArrayPos.Find(PayloadId))
+	{
+		Items[*PositionPtr].ReferenceCount++;
+	}
+}
+
+void FBA_FFA_PayloadStore::Release(int32 PayloadId)
+{
+	const int32* PositionPtr = PayloadIdToArrayPos.Find(PayloadId);
+	if (!PositionPtr)
+	{
+		return;
+	}
+	const int32 Position = *PositionPtr;
+	if (--Items[Position].ReferenceCount > 0)
+	{
+		return;
+	}
+
+	ContentHashToPayloadId.RemoveSingle(Items[Position].ContentHash, PayloadId);
+	PayloadIdToArrayPos.Remove(PayloadId);
+	Items.RemoveAtSwap(Position, 1, EAllowShrinking::No);
+	if (Items.IsValidIndex(Position))
+	{
+		PayloadIdToArrayPos.Add(Items[Position].PayloadId, Position);
+	}
+	MarkArrayDirty();
+}
+
+const FBA_FPayload* FBA_FFA_PayloadStore::Find(int32 PayloadId) const
+{
+	if (const int32* PositionPtr = PayloadIdToArrayPos.Find(PayloadId);
+		PositionPtr && Items.IsValidIndex(*PositionPtr) && Items[*PositionPtr].PayloadId == PayloadId)
+	{
+		return &Items[*PositionPtr].Payload;
+	}
+	return nullptr;
+}
+
+void FBA_FFA_PayloadStore::Clear()
+{
+	Items.Empty();
+	PayloadIdToArrayPos.Empty();
+	ContentHashToPayloadId.Empty();
+	MarkArrayDirty();
+}
+
+void FBA_FFA_PayloadStore::RebuildIndexMap()
+{
+	PayloadIdToArrayPos.Empty(Items.Num());
+	for (int32 Position = 0; Position < Items.Num(); Position++)
+	{
+		PayloadIdToArrayPos.Add(Items[Position].PayloadId, Position);
+	}
+}
+
+#pragma endregion
+
+#pragma region Networking
+
+void FBA_FFA_PayloadStore::PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize)
+{
+	for (int32 Index : RemovedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			PayloadIdToArrayPos.Remove(Items[Index].PayloadId);
+		}
+	}
+	bIndexMapDirty = true;
+}
+
+void FBA_FFA_PayloadStore::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	// make new payloads available to entries received in the same update
+	for (int32 Index : AddedIndices)
+	{
+		if (Items.IsValidIndex(Index))
+		{
+			PayloadIdToArrayPos.Add(Items[Index].PayloadId, Index);
+			ReceivedPayloadIds.Add(Items[Index].PayloadId);
+		}
+	}
+}
+
+void FBA_FFA_PayloadStore::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	// removed payloads are swapped out after the callbacks, positions need to be rebuilt
+	if (bIndexMapDirty)
+	{
+		RebuildIndexMap();
+		bIndexMapDirty = false;
+	}
+	// entries that arrived before their payload can be read now
+	for (const int32 PayloadId : ReceivedPayloadIds)
+	{
+		OnPayloadReceived.ExecuteIfBound(PayloadId);
+	}
+	ReceivedPayloadIds.Reset();
+}
+
+bool FBA_FFA_PayloadStore::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	return FFastArraySerializer::FastArrayDeltaSerialize<FBA_FFA_SharedPayload, FBA_FFA_PayloadStore>(Items, DeltaParms, *this);
+}
+
+#pragma endregion
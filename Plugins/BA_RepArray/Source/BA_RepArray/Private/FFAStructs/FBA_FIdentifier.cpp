@@ -0,0 +1,226 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FIdentifier.h"
+#include "Interfaces/IPluginManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Logging/StructuredLog.h"
+#include "BA_RepArray.h"
+
+#pragma region FBA_FIdentifierDictionary
+
+const FBA_FIdentifierDictionary& FBA_FIdentifierDictionary::Get()
+{
+	static const FBA_FIdentifierDictionary Dictionary;
+	return Dictionary;
+}
+
+FBA_FIdentifierDictionary::FBA_FIdentifierDictionary()
+{
+	LoadFileToArray("Adjectives.txt", Adjectives);
+	LoadFileToArray("Names.txt", Names);
+
+	// indices are replicated as uint16
+	Adjectives.SetNum(FMath::Min(Adjectives.Num(), static_cast<int32>(MAX_uint16)));
+	Names.SetNum(FMath::Min(Names.Num(), static_cast<int32>(MAX_uint16)));
+	for (int32 Index = 0; Index < Adjectives.Num(); Index++)
+	{
+		AdjectiveToIndex.Add(Adjectives[Index], static_cast<uint16>(Index));
+	}
+	for (int32 Index = 0; Index < Names.Num(); Index++)
+	{
+		NameToIndex.Add(Names[Index], static_cast<uint16>(Index));
+	}
+}
+
+bool FBA_FIdentifierDictionary::LoadFileToArray(const FString& FileName, TArray<FString>& TargetArray)
+{
+	// check plugin name
+	FString PluginName = TEXT("BA_RepArray");
+	TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(PluginName);
+	if (!Plugin.IsValid())
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Plugin name '{plugin}' is not valid"
+			, __FUNCTION__, PluginName);
+		return false;
+	}
+	// get resource dir and check file
+	const FString ResourceDir = "Resources";
+	const FString DataFilesDir = "DataFiles";
+	const FString FilePath = FPaths::Combine(
+		*Plugin->GetBaseDir()
+		, *ResourceDir
+		, *DataFilesDir
+		, *FileName);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*FilePath))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: File '{file}' does not exist"
+			, __FUNCTION__, FilePath);
+		return false;
+	}
+	// load file
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Error loading file '{file}'"
+			, __FUNCTION__, FilePath);
+		return false;
+	}
+	TargetArray.Empty();
+	for (FString& Line : Lines)
+	{
+		if (!Line.IsEmpty())
+		{
+			TargetArray.Push(MoveTemp(Line));
+		}
+	}
+
+	UE_LOGFMT(Log_BA_IM_RepArray, Log, "{function}: Loaded '{file}' with {count} entries"
+		, __FUNCTION__, FilePath, TargetArray.Num());
+	return true;
+}
+
+FString FBA_FIdentifierDictionary::BuildString(uint16 FirstAdjective, uint16 SecondAdjective, uint16 Name) const
+{
+	if (!Adjectives.IsValidIndex(FirstAdjective) || !Adjectives.IsValidIndex(SecondAdjective) || !Names.IsValidIndex(Name))
+	{
+		return FString();
+	}
+	return Adjectives[FirstAdjective] + Adjectives[SecondAdjective] + Names[Name];
+}
+
+bool FBA_FIdentifierDictionary::ParseString(const FString& Identifier, uint16& OutFirstAdjective, uint16& OutSecondAdjective, uint16& OutName) const
+{
+	// words are concatenated without separator, try every split
+	const int32 Length = Identifier.Len();
+	for (int32 FirstEnd = 1; FirstEnd < Length - 1; FirstEnd++)
+	{
+		const uint16* FirstPtr = AdjectiveToIndex.Find(Identifier.Left(FirstEnd));
+		if (!FirstPtr)
+		{
+			continue;
+		}
+		for (int32 SecondEnd = FirstEnd + 1; SecondEnd < Length; SecondEnd++)
+		{
+			const uint16* SecondPtr = AdjectiveToIndex.Find(Identifier.Mid(FirstEnd, SecondEnd - FirstEnd));
+			if (!SecondPtr)
+			{
+				continue;
+			}
+			if (const uint16* NamePtr = NameToIndex.Find(Identifier.RightChop(SecondEnd)))
+			{
+				OutFirstAdjective = *FirstPtr;
+				OutSecondAdjective = *SecondPtr;
+				OutName = *NamePtr;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+#pragma endregion
+
+#pragma region FBA_FIdentifier
+
+FBA_FIdentifier FBA_FIdentifier::FromDictionary(uint16 FirstAdjective, uint16 SecondAdjective, uint16 Name)
+{
+	FBA_FIdentifier Identifier;
+	Identifier.Kind = EKind::Dictionary;
+	Identifier.Words[0] = FirstAdjective;
+	Identifier.Words[1] = SecondAdjective;
+	Identifier.Words[2] = Name;
+	return Identifier;
+}
+
+FBA_FIdentifier FBA_FIdentifier::FromName(FName Name)
+{
+	FBA_FIdentifier Identifier;
+	if (!Name.IsNone())
+	{
+		Identifier.Kind = EKind::Name;
+		Identifier.CustomName = Name;
+	}
+	return Identifier;
+}
+
+FBA_FIdentifier FBA_FIdentifier::FromString(const FString& Identifier)
+{
+	if (Identifier.IsEmpty())
+	{
+		return FBA_FIdentifier();
+	}
+	if (uint16 First, Second, Name;
+		FBA_FIdentifierDictionary::Get().ParseString(Identifier, First, Second, Name))
+	{
+		return FromDictionary(First, Second, Name);
+	}
+	return FromName(FName(*Identifier));
+}
+
+bool FBA_FIdentifier::FindFromString(const FString& Identifier, FBA_FIdentifier& OutIdentifier)
+{
+	if (Identifier.IsEmpty())
+	{
+		return false;
+	}
+	if (uint16 First, Second, Name;
+		FBA_FIdentifierDictionary::Get().ParseString(Identifier, First, Second, Name))
+	{
+		OutIdentifier = FromDictionary(First, Second, Name);
+		return true;
+	}
+	// a name that was never created cannot be the identifier of an entry
+	const FName ExistingName(*Identifier, FNAME_Find);
+	if (ExistingName.IsNone())
+	{
+		return false;
+	}
+	OutIdentifier = FromName(ExistingName);
+	return true;
+}
+
+FString FBA_FIdentifier::ToString(const FGuid& InstanceGuid) const
+{
+	switch (Kind)
+	{
+	case EKind::Dictionary:
+		return FBA_FIdentifierDictionary::Get().BuildString(Words[0], Words[1], Words[2]);
+	case EKind::Name:
+		return CustomName.ToString();
+	default:
+		return InstanceGuid.ToString();
+	}
+}
+
+bool FBA_FIdentifier::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedKind = static_cast<uint32>(Kind);
+	Ar.SerializeInt(PackedKind, static_cast<uint32>(EKind::Name) + 1);
+	if (Ar.IsLoading())
+	{
+		Kind = static_cast<EKind>(PackedKind);
+	}
+
+	if (Kind == EKind::Dictionary)
+	{
+		for (uint16& Word : Words)
+		{
+			uint32 PackedWord = Word;
+			Ar.SerializeIntPacked(PackedWord);
+			Word = static_cast<uint16>(PackedWord);
+		}
+	}
+	else if (Kind == EKind::Name)
+	{
+		Ar << CustomName;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+#pragma endregion
@@ -0,0 +1,123 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FPayload.h"
+#include "Logging/StructuredLog.h"
+#include "Misc/Compression.h"
+#include "BA_RepArray.h"
+
+void FBA_FPayload::Reset()
+{
+	Data.Empty();
+	Codec = EBA_ECompressionCodec::E_None;
+	UncompressedSize = 0;
+}
+
+FName FBA_FPayload::GetCompressionFormatName(EBA_ECompressionCodec CompressionCodec)
+{
+	switch (CompressionCodec)
+	{
+	case EBA_ECompressionCodec::E_LZ4:
+		return NAME_LZ4;
+	case EBA_ECompressionCodec::E_Zlib:
+		return NAME_Zlib;
+	case EBA_ECompressionCodec::E_Oodle:
+		return NAME_Oodle;
+	default:
+		return NAME_None;
+	}
+}
+
+bool FBA_FPayload::Compress(EBA_ECompressionCodec NewCodec, int32 MinSizeToCompress)
+{
+	if (IsCompressed())
+	{
+		return true;
+	}
+	const FName FormatName = GetCompressionFormatName(NewCodec);
+	if (FormatName.IsNone() || Data.Num() == 0 || Data.Num() < MinSizeToCompress)
+	{
+		return false;
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Data.Num());
+	TArray<uint8> CompressedData;
+	CompressedData.SetNumUninitialized(CompressedSize);
+
+	// compress and decompress with the same format - the old implementation mixed LZ4 and Zlib
+	if (!FCompression::CompressMemory(FormatName, CompressedData.GetData(), CompressedSize, Data.GetData(), Data.Num()))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Warning, "{function}: Compressing {size} bytes with '{format}' failed, payload stays uncompressed"
+			, __FUNCTION__, Data.Num(), FormatName.ToString());
+		return false;
+	}
+	// keep uncompressed if compression does not pay off
+	if (CompressedSize >= Data.Num())
+	{
+		return false;
+	}
+
+	CompressedData.SetNum(CompressedSize);
+	UncompressedSize = Data.Num();
+	Data = MoveTemp(CompressedData);
+	Codec = NewCodec;
+	return true;
+}
+
+const TArray<uint8>* FBA_FPayload::GetUncompressedData(TArray<uint8>& DecompressionBuffer) const
+{
+	if (!IsCompressed())
+	{
+		return &Data;
+	}
+
+	const FName FormatName = GetCompressionFormatName(Codec);
+	DecompressionBuffer.SetNumUninitialized(UncompressedSize);
+	if (FormatName.IsNone()
+		|| !FCompression::UncompressMemory(FormatName, DecompressionBuffer.GetData(), UncompressedSize, Data.GetData(), Data.Num()))
+	{
+		UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Decompressing payload with '{format}' failed"
+			, __FUNCTION__, FormatName.ToString());
+		DecompressionBuffer.Reset();
+		return nullptr;
+	}
+	return &DecompressionBuffer;
+}
+
+bool FBA_FPayload::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	// codec takes 2 bits, the uncompressed size is only sent for compressed payloads
+	uint32 CodecValue = static_cast<uint32>(Codec);
+	Ar.SerializeInt(CodecValue, static_cast<uint32>(EBA_ECompressionCodec::E_UNDEFINED));
+
+	uint32 Size = Data.Num();
+	Ar.SerializeIntPacked(Size);
+
+	uint32 RawSize = IsCompressed() ? static_cast<uint32>(UncompressedSize) : 0;
+	if (CodecValue != static_cast<uint32>(EBA_ECompressionCodec::E_None))
+	{
+		Ar.SerializeIntPacked(RawSize);
+	}
+
+	if (Ar.IsLoading())
+	{
+		if (Size > MaxNetPayloadSize || RawSize > MaxUncompressedSize)
+		{
+			UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Received payload size {size} (uncompressed {raw}) exceeds the limit"
+				, __FUNCTION__, Size, RawSize);
+			Ar.SetError();
+			bOutSuccess = false;
+			return true;
+		}
+		Codec = static_cast<EBA_ECompressionCodec>(CodecValue);
+		UncompressedSize = static_cast<int32>(RawSize);
+		Data.SetNumUninitialized(Size);
+	}
+
+	if (Size > 0)
+	{
+		Ar.Serialize(Data.GetData(), Size);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
@@ -0,0 +1,55 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FPropertyIndex.h"
+
+void FBA_FPropertyIndex::Reset(TArray<TPair<FBA_FEntryHandle, FBA_FSortKey>>&& Entries)
+{
+	Clear();
+	Keys.Reserve(Entries.Num());
+	for (TPair<FBA_FEntryHandle, FBA_FSortKey>& Entry : Entries)
+	{
+		Set(Entry.Key, MoveTemp(Entry.Value));
+	}
+}
+
+void FBA_FPropertyIndex::Set(const FBA_FEntryHandle& Handle, FBA_FSortKey&& Key)
+{
+	if (const FBA_FSortKey* OldKey = Keys.Find(Handle))
+	{
+		if (*OldKey == Key)
+		{
+			return;
+		}
+		Remove(Handle);
+	}
+	if (Key.GetType() == FBA_FSortKey::EType::None)
+	{
+		return;
+	}
+	Buckets.FindOrAdd(Key).Add(Handle);
+	Keys.Add(Handle, MoveTemp(Key));
+}
+
+bool FBA_FPropertyIndex::Remove(const FBA_FEntryHandle& Handle)
+{
+	FBA_FSortKey Key;
+	if (!Keys.RemoveAndCopyValue(Handle, Key))
+	{
+		return false;
+	}
+	if (TSet<FBA_FEntryHandle>* Bucket = Buckets.Find(Key))
+	{
+		Bucket->Remove(Handle);
+		if (Bucket->IsEmpty())
+		{
+			Buckets.Remove(Key);
+		}
+	}
+	return true;
+}
+
+void FBA_FPropertyIndex::Clear()
+{
+	Buckets.Reset();
+	Keys.Reset();
+}
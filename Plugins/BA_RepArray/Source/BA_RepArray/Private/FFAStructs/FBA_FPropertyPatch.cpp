@@ -0,0 +1,76 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FPropertyPatch.h"
+#include "Logging/StructuredLog.h"
+#include "BA_RepArray.h"
+
+#pragma region FBA_FPropertyValue
+
+bool FBA_FPropertyValue::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 Index = PropertyIndex;
+	uint32 PackedRevision = static_cast<uint32>(Revision);
+	uint32 Size = Value.Num();
+	Ar.SerializeIntPacked(Index);
+	Ar.SerializeIntPacked(PackedRevision);
+	Ar.SerializeIntPacked(Size);
+
+	if (Ar.IsLoading())
+	{
+		if (Index > MAX_uint16 || Size > MaxNetValueSize)
+		{
+			UE_LOGFMT(Log_BA_IM_RepArray, Error, "{function}: Received invalid property value (index {index}, size {size})"
+				, __FUNCTION__, Index, Size);
+			Ar.SetError();
+			bOutSuccess = false;
+			return true;
+		}
+		PropertyIndex = static_cast<uint16>(Index);
+		Revision = static_cast<int32>(PackedRevision);
+		Value.SetNumUninitialized(Size);
+	}
+
+	if (Size > 0)
+	{
+		Ar.Serialize(Value.GetData(), Size);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+#pragma endregion
+
+#pragma region FBA_FPropertyPatch
+
+void FBA_FPropertyPatch::SetValue(uint16 PropertyIndex, TArray<uint8>&& SerializedValue)
+{
+	if (FBA_FPropertyValue* Existing = Values.FindByPredicate([PropertyIndex](const FBA_FPropertyValue& PropertyValue)
+		{
+			return PropertyValue.PropertyIndex == PropertyIndex;
+		}))
+	{
+		Existing->Value = MoveTemp(SerializedValue);
+		Existing->Revision = Revision;
+		return;
+	}
+	Values.Emplace(PropertyIndex, Revision, MoveTemp(SerializedValue));
+}
+
+int32 FBA_FPropertyPatch::GetByteSize() const
+{
+	int32 ByteSize = 0;
+	for (const FBA_FPropertyValue& PropertyValue : Values)
+	{
+		ByteSize += PropertyValue.Value.Num();
+	}
+	return ByteSize;
+}
+
+void FBA_FPropertyPatch::Reset()
+{
+	Values.Empty();
+	Revision = 0;
+}
+
+#pragma endregion
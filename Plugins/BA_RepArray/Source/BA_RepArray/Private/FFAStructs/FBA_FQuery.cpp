@@ -0,0 +1,260 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FQuery.h"
+#include "Algo/AllOf.h"
+#include "Logging/StructuredLog.h"
+#include "BA_RepArray.h"
+
+#pragma region FBA_FQueryPlan
+
+FBA_FQueryPlan FBA_FQueryPlan::Compile(const FBA_FQuery& Query, const UStruct* EntryType)
+{
+	FBA_FQueryPlan Plan;
+	Plan.bMatchesAll = Query.AnyOf.IsEmpty();
+	for (const FBA_FQueryClause& Clause : Query.AnyOf)
+	{
+		TArray<FPredicate> Predicates;
+		bool bCanMatch = EntryType != nullptr;
+		for (const FBA_FQueryPredicate& QueryPredicate : Clause.AllOf)
+		{
+			if (!bCanMatch)
+			{
+				break;
+			}
+			if (QueryPredicate.Operator == EBA_EQueryOperator::E_ClassIs)
+			{
+				// only depends on the type, matching predicates are dropped
+				bCanMatch = QueryPredicate.Class
+					? EntryType->IsChildOf(QueryPredicate.Class.Get())
+					: EntryType->GetName().Equals(QueryPredicate.Value, ESearchCase::IgnoreCase);
+				continue;
+			}
+
+			// resolve the path through nested structs
+			FPredicate Predicate;
+			Predicate.Operator = QueryPredicate.Operator;
+			TArray<FString> PathNames;
+			QueryPredicate.PropertyPath.ParseIntoArray(PathNames, TEXT("."));
+			const UStruct* Type = EntryType;
+			for (int32 Index = 0; Index < PathNames.Num() && Type; Index++)
+			{
+				const FProperty* Property = Type->FindPropertyByName(FName(*PathNames[Index]));
+				if (Index == PathNames.Num() - 1)
+				{
+					Predicate.Property = Property;
+				}
+				else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+				{
+					Predicate.Path.Add(StructProperty);
+					Type = StructProperty->Struct;
+				}
+				else
+				{
+					Type = nullptr;
+				}
+			}
+			if (!Predicate.Property)
+			{
+				// entries without the property never match
+				bCanMatch = false;
+				continue;
+			}
+
+			const FProperty* ValueProperty = Predicate.Property;
+			if (Predicate.Operator == EBA_EQueryOperator::E_Contains)
+			{
+				if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Predicate.Property))
+				{
+					Predicate.ElementProperty = ArrayProperty->Inner;
+				}
+				else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Predicate.Property))
+				{
+					Predicate.ElementProperty = SetProperty->ElementProp;
+				}
+				ValueProperty = Predicate.ElementProperty ? Predicate.ElementProperty : ValueProperty;
+			}
+			Predicate.Value = ParseValue(ValueProperty, QueryPredicate.Value);
+			Predicate.MaxValue = ParseValue(ValueProperty, QueryPredicate.MaxValue);
+			Predicates.Add(MoveTemp(Predicate));
+		}
+
+		if (!bCanMatch)
+		{
+			continue;
+		}
+		if (Predicates.IsEmpty())
+		{
+			Plan.bMatchesAll = true;
+			continue;
+		}
+		Plan.bReadsProperties = true;
+		Plan.Clauses.Add(MoveTemp(Predicates));
+	}
+	UE_LOGFMT(Log_BA_IM_RepArray, Verbose, "{function}: Query compiled for '{type}' with {clauses} clauses"
+		, __FUNCTION__, EntryType ? EntryType->GetName() : FString(TEXT("None")), Plan.Clauses.Num());
+	return Plan;
+}
+
+bool FBA_FQueryPlan::Matches(const TFunctionRef<const void*()>& GetContainer) const
+{
+	if (bMatchesAll)
+	{
+		return true;
+	}
+	const void* Container = nullptr;
+	for (const TArray<FPredicate>& Clause : Clauses)
+	{
+		if (!Container)
+		{
+			Container = GetContainer();
+			if (!Container)
+			{
+				return false;
+			}
+		}
+		if (Algo::AllOf(Clause, [Container](const FPredicate& Predicate) { return Evaluate(Predicate, Container); }))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FBA_FSortKey FBA_FQueryPlan::ParseValue(const FProperty* Property, const FString& Value)
+{
+	const FByteProperty* ByteProperty = CastField<FByteProperty>(Property);
+	const bool bEnum = Property->IsA<FEnumProperty>() || (ByteProperty && ByteProperty->Enum);
+	if (!bEnum && (Property->IsA<FNumericProperty>() || Property->IsA<FBoolProperty>()))
+	{
+		if (Value.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Value.Equals(TEXT("false"), ESearchCase::IgnoreCase))
+		{
+			return FBA_FSortKey::FromNumber(Value.ToBool() ? 1 : 0);
+		}
+		return FBA_FSortKey::FromNumber(FCString::Atod(*Value));
+	}
+	return FBA_FSortKey::FromString(Value);
+}
+
+bool FBA_FQueryPlan::Evaluate(const FPredicate& Predicate, const void* Container)
+{
+	for (const FProperty* StructProperty : Predicate.Path)
+	{
+		Container = StructProperty->ContainerPtrToValuePtr<void>(Container);
+	}
+
+	if (Predicate.ElementProperty)
+	{
+		// element properties have no offset, the element itself is the container
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Predicate.Property))
+		{
+			FScriptArrayHelper Helper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(Container));
+			for (int32 Index = 0; Index < Helper.Num(); Index++)
+			{
+				if (FBA_FSortKey::FromPropertyValue(Predicate.ElementProperty, Helper.GetRawPtr(Index)) == Predicate.Value)
+				{
+					return true;
+				}
+			}
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Predicate.Property))
+		{
+			FScriptSetHelper Helper(SetProperty, SetProperty->ContainerPtrToValuePtr<void>(Container));
+			for (int32 Index = 0; Index < Helper.GetMaxIndex(); Index++)
+			{
+				if (Helper.IsValidIndex(Index)
+					&& FBA_FSortKey::FromPropertyValue(Predicate.ElementProperty, Helper.GetElementPtr(Index)) == Predicate.Value)
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	const FBA_FSortKey Key = FBA_FSortKey::FromPropertyValue(Predicate.Property, Container);
+	// numbers and strings are not ordered against each other
+	const bool bComparable = Key.GetType() == Predicate.Value.GetType();
+	switch (Predicate.Operator)
+	{
+	case EBA_EQueryOperator::E_Equal:
+		return Key == Predicate.Value;
+	case EBA_EQueryOperator::E_NotEqual:
+		return !(Key == Predicate.Value);
+	case EBA_EQueryOperator::E_Less:
+		return bComparable && Key < Predicate.Value;
+	case EBA_EQueryOperator::E_LessEqual:
+		return bComparable && !(Predicate.Value < Key);
+	case EBA_EQueryOperator::E_Greater:
+		return bComparable && Predicate.Value < Key;
+	case EBA_EQueryOperator::E_GreaterEqual:
+		return bComparable && !(Key < Predicate.Value);
+	case EBA_EQueryOperator::E_Range:
+		return bComparable && Key.GetType() == Predicate.MaxValue.GetType()
+			&& !(Key < Predicate.Value) && !(Predicate.MaxValue < Key);
+	case EBA_EQueryOperator::E_Contains:
+		return bComparable && Key.GetType() == FBA_FSortKey::EType::String
+			&& Key.GetString().Contains(Predicate.Value.GetString());
+	default:
+		return false;
+	}
+}
+
+#pragma endregion
+
+#pragma region FBA_FFilteredView
+
+const FBA_FQueryPlan& FBA_FFilteredView::GetPlan(const UStruct* EntryType)
+{
+	if (const FBA_FQueryPlan* Plan = Plans.Find(EntryType))
+	{
+		return *Plan;
+	}
+	return Plans.Add(EntryType, FBA_FQueryPlan::Compile(Query, EntryType));
+}
+
+void FBA_FFilteredView::SetStatus(const FBA_FEntryHandle& Handle, bool bVisible)
+{
+	const EBA_EEntryStatus NewStatus = bVisible ? EBA_EEntryStatus::E_Filtered_Visible : EBA_EEntryStatus::E_Filtered_InVisible;
+	EBA_EEntryStatus& Status = Statuses.FindOrAdd(Handle, EBA_EEntryStatus::E_UNDEFINED);
+	if (Status == NewStatus)
+	{
+		return;
+	}
+	VisibleCount += bVisible ? 1 : (Status == EBA_EEntryStatus::E_Filtered_Visible ? -1 : 0);
+	Status = NewStatus;
+	if (Handle.GetSlot() >= VisibleSlots.Num())
+	{
+		VisibleSlots.SetNum(FMath::Max(Handle.GetSlot() + 1, VisibleSlots.Num() * 2), false);
+	}
+	VisibleSlots[Handle.GetSlot()] = bVisible;
+}
+
+bool FBA_FFilteredView::Remove(const FBA_FEntryHandle& Handle)
+{
+	EBA_EEntryStatus Status;
+	if (!Statuses.RemoveAndCopyValue(Handle, Status))
+	{
+		return false;
+	}
+	if (Status == EBA_EEntryStatus::E_Filtered_Visible)
+	{
+		VisibleCount--;
+		VisibleSlots[Handle.GetSlot()] = false;
+	}
+	return true;
+}
+
+void FBA_FFilteredView::Clear()
+{
+	Statuses.Reset();
+	VisibleSlots.Reset();
+	VisibleCount = 0;
+}
+
+EBA_EEntryStatus FBA_FFilteredView::GetStatus(const FBA_FEntryHandle& Handle) const
+{
+	const EBA_EEntryStatus* Status = Statuses.Find(Handle);
+	return Status ? *Status : EBA_EEntryStatus::E_UNDEFINED;
+}
+
+#pragma endregion
@@ -0,0 +1,135 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FRangeIndex.h"
+
+namespace
+{
+	bool IsBefore(const FBA_FRangeIndex::FEntry& EntryA, double ValueB, const FBA_FEntryHandle& HandleB)
+	{
+		if (EntryA.Value != ValueB)
+		{
+			return EntryA.Value < ValueB;
+		}
+		// equal values keep a fixed order
+		return EntryA.Handle.GetSlot() < HandleB.GetSlot()
+			|| (EntryA.Handle.GetSlot() == HandleB.GetSlot() && EntryA.Handle.GetGeneration() < HandleB.GetGeneration());
+	}
+}
+
+void FBA_FRangeIndex::Reset(TArray<FEntry>&& InEntries)
+{
+	Entries = MoveTemp(InEntries);
+	Entries.Sort([](const FEntry& EntryA, const FEntry& EntryB)
+		{
+			return IsBefore(EntryA, EntryB.Value, EntryB.Handle);
+		});
+	Values.Empty(Entries.Num());
+	for (const FEntry& Entry : Entries)
+	{
+		Values.Add(Entry.Handle, Entry.Value);
+	}
+}
+
+void FBA_FRangeIndex::Set(const FBA_FEntryHandle& Handle, double Value)
+{
+	if (const double* OldValue = Values.Find(Handle))
+	{
+		if (*OldValue == Value)
+		{
+			return;
+		}
+		Remove(Handle);
+	}
+	Entries.Insert(FEntry{ Value, Handle }, LowerBound(Value, Handle));
+	Values.Add(Handle, Value);
+}
+
+bool FBA_FRangeIndex::Remove(const FBA_FEntryHandle& Handle)
+{
+	double Value;
+	if (!Values.RemoveAndCopyValue(Handle, Value))
+	{
+		return false;
+	}
+	if (const int32 Position = LowerBound(Value, Handle);
+		Entries.IsValidIndex(Position) && Entries[Position].Handle == Handle)
+	{
+		Entries.RemoveAt(Position, 1, EAllowShrinking::No);
+	}
+	return true;
+}
+
+void FBA_FRangeIndex::Clear()
+{
+	Entries.Reset();
+	Values.Reset();
+}
+
+void FBA_FRangeIndex::GetRange(double Min, double Max, int32 MaxCount, TArray<FBA_FEntryHandle>& OutHandles) const
+{
+	OutHandles.Reset();
+	if (Max < Min)
+	{
+		return;
+	}
+	for (int32 Position = LowerBound(Min); Position < Entries.Num() && Entries[Position].Value <= Max; Position++)
+	{
+		if (MaxCount > 0 && OutHandles.Num() >= MaxCount)
+		{
+			break;
+		}
+		OutHandles.Add(Entries[Position].Handle);
+	}
+}
+
+void FBA_FRangeIndex::GetByRank(int32 First, int32 Count, bool bDescending, TArray<FBA_FEntryHandle>& OutHandles) const
+{
+	OutHandles.Reset();
+	First = FMath::Max(First, 0);
+	const int32 Last = FMath::Min(First + FMath::Max(Count, 0), Entries.Num());
+	OutHandles.Reserve(FMath::Max(Last - First, 0));
+	for (int32 Rank = First; Rank < Last; Rank++)
+	{
+		OutHandles.Add(Entries[bDescending ? Entries.Num() - 1 - Rank : Rank].Handle);
+	}
+}
+
+int32 FBA_FRangeIndex::LowerBound(double Value) const
+{
+	int32 First = 0;
+	int32 Count = Entries.Num();
+	while (Count > 0)
+	{
+		const int32 Step = Count / 2;
+		if (Entries[First + Step].Value < Value)
+		{
+			First += Step + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+	return First;
+}
+
+int32 FBA_FRangeIndex::LowerBound(double Value, const FBA_FEntryHandle& Handle) const
+{
+	int32 First = 0;
+	int32 Count = Entries.Num();
+	while (Count > 0)
+	{
+		const int32 Step = Count / 2;
+		if (IsBefore(Entries[First + Step], Value, Handle))
+		{
+			First += Step + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+	return First;
+}
@@ -0,0 +1,127 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FSlotMap.h"
+
+FBA_FEntryHandle FBA_FSlotMap::Add(int32 DenseIndex)
+{
+	if (DenseIndex < 0)
+	{
+		return FBA_FEntryHandle();
+	}
+	if (DenseIndex >= DenseToSlot.Num())
+	{
+		SetNum(DenseIndex + 1);
+	}
+	// an element still linked at this position is replaced
+	Remove(DenseIndex);
+
+	const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = DenseIndex;
+	DenseToSlot[DenseIndex] = SlotIndex;
+	return FBA_FEntryHandle(SlotIndex, Slot.Generation);
+}
+
+int32 FBA_FSlotMap::Find(const FBA_FEntryHandle& Handle) const
+{
+	if (!Slots.IsValidIndex(Handle.GetSlot()))
+	{
+		return INDEX_NONE;
+	}
+	const FSlot& Slot = Slots[Handle.GetSlot()];
+	return Slot.Generation == Handle.GetGeneration() ? Slot.DenseIndex : INDEX_NONE;
+}
+
+FBA_FEntryHandle FBA_FSlotMap::GetHandle(int32 DenseIndex) const
+{
+	if (!DenseToSlot.IsValidIndex(DenseIndex) || DenseToSlot[DenseIndex] == INDEX_NONE)
+	{
+		return FBA_FEntryHandle();
+	}
+	const int32 SlotIndex = DenseToSlot[DenseIndex];
+	return FBA_FEntryHandle(SlotIndex, Slots[SlotIndex].Generation);
+}
+
+void FBA_FSlotMap::Remove(int32 DenseIndex)
+{
+	if (!DenseToSlot.IsValidIndex(DenseIndex) || DenseToSlot[DenseIndex] == INDEX_NONE)
+	{
+		return;
+	}
+	const int32 SlotIndex = DenseToSlot[DenseIndex];
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.DenseIndex = INDEX_NONE;
+	// all handles to this slot become stale
+	Slot.Generation++;
+	FreeSlots.Add(SlotIndex);
+	DenseToSlot[DenseIndex] = INDEX_NONE;
+}
+
+void FBA_FSlotMap::Move(int32 From, int32 To)
+{
+	if (From == To || !DenseToSlot.IsValidIndex(From) || !DenseToSlot.IsValidIndex(To))
+	{
+		return;
+	}
+	Remove(To);
+	const int32 SlotIndex = DenseToSlot[From];
+	if (SlotIndex != INDEX_NONE)
+	{
+		Slots[SlotIndex].DenseIndex = To;
+	}
+	DenseToSlot[To] = SlotIndex;
+	DenseToSlot[From] = INDEX_NONE;
+}
+
+void FBA_FSlotMap::RemoveAtSwap(int32 DenseIndex)
+{
+	if (!DenseToSlot.IsValidIndex(DenseIndex))
+	{
+		return;
+	}
+	const int32 LastIndex = DenseToSlot.Num() - 1;
+	Remove(DenseIndex);
+	Move(LastIndex, DenseIndex);
+	DenseToSlot.SetNum(LastIndex, EAllowShrinking::No);
+}
+
+void FBA_FSlotMap::SetNum(int32 NewNum)
+{
+	NewNum = FMath::Max(NewNum, 0);
+	for (int32 DenseIndex = NewNum; DenseIndex < DenseToSlot.Num(); DenseIndex++)
+	{
+		Remove(DenseIndex);
+	}
+	const int32 OldNum = DenseToSlot.Num();
+	DenseToSlot.SetNum(NewNum, EAllowShrinking::No);
+	for (int32 DenseIndex = OldNum; DenseIndex < NewNum; DenseIndex++)
+	{
+		DenseToSlot[DenseIndex] = INDEX_NONE;
+	}
+}
+
+bool FBA_FSlotMap::Relink(int32 DenseIndex, const FBA_FEntryHandle& Handle)
+{
+	if (!DenseToSlot.IsValidIndex(DenseIndex) || Find(Handle) == INDEX_NONE)
+	{
+		return false;
+	}
+	Slots[Handle.GetSlot()].DenseIndex = DenseIndex;
+	DenseToSlot[DenseIndex] = Handle.GetSlot();
+	return true;
+}
+
+void FBA_FSlotMap::Reset()
+{
+	for (int32 DenseIndex = 0; DenseIndex < DenseToSlot.Num(); DenseIndex++)
+	{
+		Remove(DenseIndex);
+	}
+	DenseToSlot.Reset();
+}
+
+void FBA_FSlotMap::Reserve(int32 Number)
+{
+	Slots.Reserve(Number);
+	DenseToSlot.Reserve(Number);
+}
@@ -0,0 +1,88 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FSortKey.h"
+
+FBA_FSortKey FBA_FSortKey::FromProperty(const FProperty* Property, const void* Container)
+{
+	FBA_FSortKey Key;
+	if (!Property || !Container)
+	{
+		return Key;
+	}
+	const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(Container);
+
+	if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		Key.Type = EType::Numeric;
+		if (NumericProperty->IsFloatingPoint())
+		{
+			return FromNumber(NumericProperty->GetFloatingPointPropertyValue(ValuePtr));
+		}
+		else if (Property->IsA<FUInt64Property>() || Property->IsA<FUInt32Property>())
+		{
+			Key.Number = static_cast<double>(NumericProperty->GetUnsignedIntPropertyValue(ValuePtr));
+		}
+		else
+		{
+			Key.Number = static_cast<double>(NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+		}
+	}
+	else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		Key.Type = EType::Numeric;
+		Key.Number = static_cast<double>(EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr));
+	}
+	else if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+	{
+		Key.Type = EType::Numeric;
+		Key.Number = BoolProperty->GetPropertyValue(ValuePtr) ? 1 : 0;
+	}
+	else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+	{
+		Key.Type = EType::String;
+		Key.String = StrProperty->GetPropertyValue(ValuePtr);
+	}
+	else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+	{
+		Key.Type = EType::String;
+		Key.String = NameProperty->GetPropertyValue(ValuePtr).ToString();
+	}
+	else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+	{
+		Key.Type = EType::String;
+		Key.String = TextProperty->GetPropertyValue(ValuePtr).ToString();
+	}
+	else
+	{
+		// everything else compares by its text export
+		Key.Type = EType::String;
+		Property->ExportTextItem_Direct(Key.String, ValuePtr, nullptr, nullptr, PPF_None);
+	}
+	return Key;
+}
+
+FBA_FSortKey FBA_FSortKey::FromPropertyValue(const FProperty* Property, const void* Container)
+{
+	if (!Property || !Container)
+	{
+		return FBA_FSortKey();
+	}
+	const UEnum* Enum = nullptr;
+	const FNumericProperty* UnderlyingProperty = nullptr;
+	if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		Enum = EnumProperty->GetEnum();
+		UnderlyingProperty = EnumProperty->GetUnderlyingProperty();
+	}
+	else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+	{
+		Enum = ByteProperty->Enum;
+		UnderlyingProperty = ByteProperty;
+	}
+	if (Enum && UnderlyingProperty)
+	{
+		const int64 Value = UnderlyingProperty->GetSignedIntPropertyValue(Property->ContainerPtrToValuePtr<void>(Container));
+		return FromString(Enum->GetNameStringByValue(Value));
+	}
+	return FromProperty(Property, Container);
+}
@@ -0,0 +1,130 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#include "FFAStructs/FBA_FSortedView.h"
+
+void FBA_FSortedView::Reset(TArray<TPair<FBA_FEntryHandle, FBA_FSortKey>>&& Entries)
+{
+	Entries.Sort([this](const TPair<FBA_FEntryHandle, FBA_FSortKey>& EntryA, const TPair<FBA_FEntryHandle, FBA_FSortKey>& EntryB)
+		{
+			return IsBefore(EntryA.Value, EntryA.Key, EntryB.Value, EntryB.Key);
+		});
+	Handles.Reset(Entries.Num());
+	Keys.Empty(Entries.Num());
+	for (TPair<FBA_FEntryHandle, FBA_FSortKey>& Entry : Entries)
+	{
+		Handles.Add(Entry.Key);
+		Keys.Add(Entry.Key, MoveTemp(Entry.Value));
+	}
+}
+
+void FBA_FSortedView::Insert(const FBA_FEntryHandle& Handle, FBA_FSortKey&& Key)
+{
+	if (Keys.Contains(Handle))
+	{
+		Update(Handle, MoveTemp(Key));
+		return;
+	}
+	Handles.Insert(Handle, LowerBound(Key, Handle));
+	Keys.Add(Handle, MoveTemp(Key));
+}
+
+bool FBA_FSortedView::Remove(const FBA_FEntryHandle& Handle)
+{
+	const FBA_FSortKey* Key = Keys.Find(Handle);
+	if (!Key)
+	{
+		return false;
+	}
+	// LowerBound reads the key of every handle in the view, the key is dropped only once the handle is gone
+	if (const int32 Position = FindPosition(Handle, *Key);
+		Position != INDEX_NONE)
+	{
+		Handles.RemoveAt(Position, 1, EAllowShrinking::No);
+	}
+	Keys.Remove(Handle);
+	return true;
+}
+
+bool FBA_FSortedView::Update(const FBA_FEntryHandle& Handle, FBA_FSortKey&& Key)
+{
+	if (const FBA_FSortKey* OldKey = Keys.Find(Handle);
+		OldKey && *OldKey == Key)
+	{
+		return false;
+	}
+	Remove(Handle);
+	Insert(Handle, MoveTemp(Key));
+	return true;
+}
+
+int32 FBA_FSortedView::IndexOf(const FBA_FEntryHandle& Handle) const
+{
+	const FBA_FSortKey* Key = Keys.Find(Handle);
+	if (!Key)
+	{
+		return INDEX_NONE;
+	}
+	return FindPosition(Handle, *Key);
+}
+
+void FBA_FSortedView::Clear()
+{
+	Handles.Reset();
+	Keys.Reset();
+}
+
+bool FBA_FSortedView::IsBefore(const FBA_FSortKey& KeyA, const FBA_FEntryHandle& HandleA, const FBA_FSortKey& KeyB, const FBA_FEntryHandle& HandleB) const
+{
+	const bool bNoKeyA = KeyA.GetType() == FBA_FSortKey::EType::None;
+	const bool bNoKeyB = KeyB.GetType() == FBA_FSortKey::EType::None;
+	if (bNoKeyA != bNoKeyB)
+	{
+		return bNoKeyB;
+	}
+	if (KeyA < KeyB)
+	{
+		return !bDescending;
+	}
+	if (KeyB < KeyA)
+	{
+		return bDescending;
+	}
+	// equal keys keep a fixed order
+	return HandleA.GetSlot() < HandleB.GetSlot()
+		|| (HandleA.GetSlot() == HandleB.GetSlot() && HandleA.GetGeneration() < HandleB.GetGeneration());
+}
+
+int32 FBA_FSortedView::LowerBound(const FBA_FSortKey& Key, const FBA_FEntryHandle& Handle) const
+{
+	int32 First = 0;
+	int32 Count = Handles.Num();
+	while (Count > 0)
+	{
+		const int32 Step = Count / 2;
+		const int32 Middle = First + Step;
+		const FBA_FEntryHandle& MiddleHandle = Handles[Middle];
+		if (IsBefore(Keys.FindChecked(MiddleHandle), MiddleHandle, Key, Handle))
+		{
+			First = Middle + 1;
+			Count -= Step + 1;
+		}
+		else
+		{
+			Count = Step;
+		}
+	}
+	return First;
+}
+
+int32 FBA_FSortedView::FindPosition(const FBA_FEntryHandle& Handle, const FBA_FSortKey& Key) const
+{
+	if (const int32 Position = LowerBound(Key, Handle);
+		Handles.IsValidIndex(Position) && Handles[Position] == Handle)
+	{
+		return Position;
+	}
+	// only reached if the keys lost their strict weak order
+	const int32 Position = Handles.Find(Handle);
+	ensureMsgf(Position == INDEX_NONE, TEXT("Sorted view '%s' is out of order"), *PropertyName.ToString());
+	return Position;
+}
@@ -0,0 +1,61 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+* Online mean, variance and skewness (Welford, batches combined with Chan et al.).
+* Remove reverses Add exactly in real arithmetic, the owner should recompute from the values after many removals
+* to drop the accumulated rounding.
+*/
+struct BA_REPARRAY_API FBA_FMoments
+{
+public:
+
+	// Count times the same value
+	void Add(double Value, int64 Count = 1);
+
+	// false if no value is left to remove
+	bool Remove(double Value);
+
+	// adds all values of Other
+	void Combine(const FBA_FMoments& Other);
+
+	void Reset();
+
+	int64 Num() const { return Count; }
+	double GetMean() const { return Mean; }
+
+	// population variance
+	double GetVariance() const;
+	double GetStandardDeviation() const;
+	double GetSkewness() const;
+
+private:
+
+	int64 Count = 0;
+	double Mean = 0;
+	// sums of the squared and cubed differences from the mean
+	double M2 = 0;
+	double M3 = 0;
+};
+
+/**
+* Sum with Neumaier compensation, the error does not grow with the number of added values
+*/
+struct BA_REPARRAY_API FBA_FCompensatedSum
+{
+public:
+
+	void Add(double Value);
+
+	void Reset() { Total = 0; Compensation = 0; }
+
+	double Get() const { return Total + Compensation; }
+
+private:
+
+	double Total = 0;
+	// low order bits lost in Total
+	double Compensation = 0;
+};
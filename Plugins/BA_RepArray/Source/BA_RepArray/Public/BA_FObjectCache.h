@@ -0,0 +1,84 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "BA_FObjectCache.generated.h"
+
+/**
+* One materialized object of an entry, valid for the payload and patch revision it was created from
+*/
+USTRUCT()
+struct FBA_FCachedObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGuid InstanceGuid;
+
+	UPROPERTY()
+	TObjectPtr<UObject> Object;
+
+	int32 PayloadRevision = 0;
+	int32 PatchRevision = 0;
+
+	// neighbours in the usage list, INDEX_NONE at the ends
+	int32 Newer = INDEX_NONE;
+	int32 Older = INDEX_NONE;
+};
+
+/**
+* Bounded least recently used cache of deserialized entry objects, keyed by InstanceGuid.
+* Cached objects are shared between all callers and must be treated as read only.
+*/
+USTRUCT()
+struct FBA_FObjectCache
+{
+	GENERATED_BODY()
+
+public:
+
+	void SetCapacity(int32 NewCapacity);
+	int32 GetCapacity() const { return Capacity; }
+	int32 Num() const { return GuidToSlot.Num(); }
+
+	/**
+	* Returns the cached object of an entry and marks it as most recently used.
+	* @param PatchRevision Patch revision the object was cached with, the caller needs to apply newer changes
+	* @return nullptr if nothing is cached for this guid and payload revision
+	*/
+	UObject* Find(const FGuid& InstanceGuid, int32 PayloadRevision, int32& PatchRevision);
+
+	// adds or replaces the object of an entry, evicts the least recently used object if the cache is full
+	void Add(const FGuid& InstanceGuid, UObject* Object, int32 PayloadRevision, int32 PatchRevision);
+
+	// updates the patch revision of a cached object after newer changes have been applied to it
+	void SetPatchRevision(const FGuid& InstanceGuid, int32 PatchRevision);
+
+	// removes the cached object of an entry
+	void Invalidate(const FGuid& InstanceGuid);
+
+	// removes the cached object of an entry if it was created from another payload revision
+	void InvalidateOutdated(const FGuid& InstanceGuid, int32 PayloadRevision);
+
+	void Clear();
+
+private:
+
+	void Unlink(int32 Slot);
+	void LinkAsNewest(int32 Slot);
+	void RemoveSlot(int32 Slot);
+
+	UPROPERTY(Transient)
+	TArray<FBA_FCachedObject> Slots;
+
+	TMap<FGuid, int32> GuidToSlot;
+
+	// unused positions in Slots
+	TArray<int32> FreeSlots;
+
+	int32 Newest = INDEX_NONE;
+	int32 Oldest = INDEX_NONE;
+
+	int32 Capacity = 0;
+};
@@ -0,0 +1,69 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+* Multiset of the values of one statistics property, kept as a treap with a count per distinct value.
+* Add, remove, min, max and k-th smallest are O(log n), so removing the current extreme values needs no rescan.
+*/
+struct BA_REPARRAY_API FBA_FOrderStatistics
+{
+public:
+
+	void Add(double Value);
+
+	// false if Value is not part of the multiset
+	bool Remove(double Value);
+
+	void Reset();
+
+	// number of values including duplicates
+	int64 Num() const { return Root == INDEX_NONE ? 0 : Nodes[Root].Size; }
+
+	bool GetMin(double& OutValue) const;
+	bool GetMax(double& OutValue) const;
+
+	// K is zero based, false if K is not below Num()
+	bool GetKthSmallest(int64 K, double& OutValue) const;
+
+	// mean of the two middle values for an even number of values
+	bool GetMedian(double& OutValue) const;
+
+	// calls Func once per distinct value in ascending order
+	void ForEachValue(TFunctionRef<void(double Value, int64 Count)> Func) const;
+
+private:
+
+	struct FNode
+	{
+		double Value = 0;
+		// duplicates of Value
+		int64 Count = 0;
+		// sum of Count in the subtree
+		int64 Size = 0;
+		uint32 Priority = 0;
+		int32 Left = INDEX_NONE;
+		int32 Right = INDEX_NONE;
+	};
+
+	// returns the new root of the subtree
+	int32 Insert(int32 NodeIndex, double Value);
+	int32 Erase(int32 NodeIndex, double Value, bool& bOutRemoved);
+	int32 RotateLeft(int32 NodeIndex);
+	int32 RotateRight(int32 NodeIndex);
+	void UpdateSize(int32 NodeIndex);
+
+	int32 NewNode(double Value);
+	void FreeNode(int32 NodeIndex);
+
+	// nodes are addressed by index, so copies of the statistics stay valid
+	TArray<FNode> Nodes;
+
+	TArray<int32> FreeNodes;
+
+	int32 Root = INDEX_NONE;
+
+	// xorshift state for the node priorities
+	uint32 Seed = 2463534242u;
+};
@@ -4,6 +4,9 @@
 #pragma once
 #include "UObject/Object.h"
 #include "Templates/TypeHash.h"
+#include "BA_FOrderStatistics.h"
+#include "BA_FMoments.h"
+#include "BA_FStatisticsSketches.h"
 #include "BA_FStatistics.generated.h"
 
 /**
@@ -32,6 +35,43 @@ public:
 	double GetLastValue()		{ return LastValue; }
 	double GetFirstValue()		{ return FirstValue; }
 	double GetMean()			{ return Mean; }
+	double GetMin()				{ return Min; }
+	double GetMax()				{ return Max; }
+	double GetMedian()			{ return Median; }
+	double GetVariance()		{ return Variance; }
+	double GetStandardDeviation()	{ return StandardDeviation; }
+	double GetSkewness()		{ return Skewness; }
+
+	// K is zero based, only available where the values were added (server)
+	bool GetKthSmallest(int64 K, double& OutValue) const { return OrderStatistics.GetKthSmallest(K, OutValue); }
+
+	// Sum with compensation of the rounding errors, only before values are added
+	void EnableCompensatedSum() { bCompensatedSum = true; }
+
+	// adds a quantile sketch and a histogram that replicate instead of the raw values
+	void EnableSketches(int32 SketchK, int32 HistogramBins)
+	{
+		bSketches = true;
+		QuantileSketch = FBA_FQuantileSketch(SketchK);
+		HistogramBinCount = FMath::Max(HistogramBins, 1);
+		RebuildSketches();
+	}
+
+	bool HasSketches() const { return bSketches; }
+
+	// Fraction between 0 and 1, exact where the values were added (server), estimated from the sketch on clients
+	bool GetQuantile(double Fraction, double& OutValue) const
+	{
+		const int64 NumValues = OrderStatistics.Num();
+		if (NumValues > 0)
+		{
+			const int64 K = FMath::Clamp<int64>(FMath::CeilToInt64(FMath::Clamp(Fraction, 0.0, 1.0) * NumValues) - 1, 0, NumValues - 1);
+			return OrderStatistics.GetKthSmallest(K, OutValue);
+		}
+		return bSketches && QuantileSketch.GetQuantile(Fraction, OutValue);
+	}
+
+	const FBA_FHistogram& GetHistogram() const { return Histogram; }
 	
 	FString ToString()
 	{
@@ -48,6 +88,10 @@ public:
 			+ ", Rang " + FText::AsNumber(Rang, &NumberFormat).ToString()
 			+ ", Min" + FText::AsNumber(Min, &NumberFormat).ToString()
 			+ ", Max " + FText::AsNumber(Max, &NumberFormat).ToString()
+			+ ", Median " + FText::AsNumber(Median, &NumberFormat).ToString()
+			+ ", Variance " + FText::AsNumber(Variance, &NumberFormat).ToString()
+			+ ", StdDev " + FText::AsNumber(StandardDeviation, &NumberFormat).ToString()
+			+ ", Skewness " + FText::AsNumber(Skewness, &NumberFormat).ToString()
 			+ ", Updated " + LastUpdate.ToString();
 			
 		return Result;
@@ -71,19 +115,41 @@ public:
 		}
 		LastValue = Value;
 		LastUpdate = FDateTime::UtcNow();
-		if (Value < Min)
+		OrderStatistics.Add(Value);
+		AddToSketches(Value);
+		UpdateOrderValues();
+		RebuildSketchesIfNeeded();
+		Moments.Add(Value);
+		AddToSum(Value);
+		UpdateMomentValues();
+	}
+
+	// adds many values with a single update of the derived values
+	void AddValues(TArrayView<const double> Values)
+	{
+		if (Values.Num() == 0)
 		{
-			LastMin = Min;
-			Min = Value;
+			return;
 		}
-		if (Value > Max)
+		FBA_FMoments BatchMoments;
+		for (const double Value : Values)
 		{
-			LastMax = Max;
-			Max = Value;
+			Count++;
+			if (Count == 1)
+			{
+				FirstValue = Value;
+			}
+			OrderStatistics.Add(Value);
+			AddToSketches(Value);
+			BatchMoments.Add(Value);
+			AddToSum(Value);
 		}
-		Rang = Max - Min;
-		Mean = ((Mean * (Count - 1)) + Value) / Count;
-		Sum += Value;
+		LastValue = Values.Last();
+		LastUpdate = FDateTime::UtcNow();
+		UpdateOrderValues();
+		RebuildSketchesIfNeeded();
+		Moments.Combine(BatchMoments);
+		UpdateMomentValues();
 	}
 
 	template <typename T>
@@ -98,19 +164,44 @@ public:
 		}
 		LastValue = Value;
 		LastUpdate = FDateTime::UtcNow();
-		if (Value == Min)
+		OrderStatistics.Remove(Value);
+		RemoveFromSketches(Value);
+		UpdateOrderValues();
+		RebuildSketchesIfNeeded();
+		Moments.Remove(Value);
+		AddToSum(-Value);
+		RemovalsSinceRecompute++;
+		RecomputeMomentsIfNeeded();
+		UpdateMomentValues();
+	}
+	// removes many values with a single update of the derived values
+	void RemoveValues(TArrayView<const double> Values)
+	{
+		if (Values.Num() == 0)
 		{
-			Min = LastMin;
-			LastMin = 0;
+			return;
 		}
-		if (Value == Max)
+		Count -= Values.Num();
+		if (Count <= 0)
 		{
-			Max = LastMax;
-			LastMax = 0;
+			Count = 0;
+			ResetValues();
+			return;
 		}
-		Rang = Max - Min;
-		Mean = ((Mean * Count - Value) / (Count - 1));
-		Sum -= Value;
+		for (const double Value : Values)
+		{
+			OrderStatistics.Remove(Value);
+			RemoveFromSketches(Value);
+			Moments.Remove(Value);
+			AddToSum(-Value);
+		}
+		LastValue = Values.Last();
+		LastUpdate = FDateTime::UtcNow();
+		UpdateOrderValues();
+		RebuildSketchesIfNeeded();
+		RemovalsSinceRecompute += Values.Num();
+		RecomputeMomentsIfNeeded();
+		UpdateMomentValues();
 	}
 #pragma endregion
 
@@ -145,18 +236,123 @@ public:
 	}
 #pragma endregion
 
+	// Min, Max, Rang and Median from the order statistics, exact after any add and remove
+	void UpdateOrderValues()
+	{
+		double Value = 0;
+		Min = OrderStatistics.GetMin(Value) ? Value : 0;
+		Max = OrderStatistics.GetMax(Value) ? Value : 0;
+		Median = OrderStatistics.GetMedian(Value) ? Value : 0;
+		Rang = Max - Min;
+	}
+
+	void AddToSum(double Value)
+	{
+		if (bCompensatedSum)
+		{
+			CompensatedSum.Add(Value);
+			Sum = CompensatedSum.Get();
+			return;
+		}
+		Sum += Value;
+	}
+
+	// Mean, Variance, StandardDeviation and Skewness from the online moments
+	void UpdateMomentValues()
+	{
+		Mean = Moments.GetMean();
+		Variance = Moments.GetVariance();
+		StandardDeviation = Moments.GetStandardDeviation();
+		Skewness = Moments.GetSkewness();
+	}
+
+	// removals leave rounding errors in the moments, recompute them and Sum from the exact values once the removals reach Count
+	void RecomputeMomentsIfNeeded()
+	{
+		if (RemovalsSinceRecompute <= Count || OrderStatistics.Num() != Count)
+		{
+			return;
+		}
+		Moments.Reset();
+		CompensatedSum.Reset();
+		OrderStatistics.ForEachValue([this](double Value, int64 ValueCount)
+			{
+				Moments.Add(Value, ValueCount);
+				CompensatedSum.Add(Value * ValueCount);
+			});
+		Sum = CompensatedSum.Get();
+		RemovalsSinceRecompute = 0;
+	}
+
+	void AddToSketches(double Value)
+	{
+		if (!bSketches)
+		{
+			return;
+		}
+		QuantileSketch.Add(Value);
+		// clamped into an edge bin until the next rebuild widens the range
+		if (!Histogram.Add(Value))
+		{
+			PendingSketchRebuild++;
+		}
+	}
+
+	// the sketch cannot forget a value, so removals count towards the next rebuild
+	void RemoveFromSketches(double Value)
+	{
+		if (bSketches)
+		{
+			Histogram.Remove(Value);
+			PendingSketchRebuild++;
+		}
+	}
+
+	// rebuild once removals and values outside of the histogram range reach 1/8 of Count, amortized O(1) per value
+	void RebuildSketchesIfNeeded()
+	{
+		if (bSketches && PendingSketchRebuild * 8 > Count)
+		{
+			RebuildSketches();
+		}
+	}
+
+	// sketch and histogram (over Min to Max) from the exact values
+	void RebuildSketches()
+	{
+		QuantileSketch.Reset();
+		Histogram.Reset(HistogramBinCount, Min, Max);
+		OrderStatistics.ForEachValue([this](double Value, int64 ValueCount)
+			{
+				for (int64 Index = 0; Index < ValueCount; Index++)
+				{
+					QuantileSketch.Add(Value);
+					Histogram.Add(Value);
+				}
+			});
+		PendingSketchRebuild = 0;
+	}
+
 	void ResetValues()
 	{
 		// reset
 		FirstValue = 0;
 		LastValue = 0;
-		LastMax = 0;
-		LastMin = 0;
 		Min = 0;
 		Max = 0;
-		LastMin = 0;
-		LastMax = 0;
+		Median = 0;
+		OrderStatistics.Reset();
+		if (bSketches)
+		{
+			RebuildSketches();
+		}
+		Moments.Reset();
+		CompensatedSum.Reset();
+		RemovalsSinceRecompute = 0;
 		Mean = 0;
+		Variance = 0;
+		StandardDeviation = 0;
+		Skewness = 0;
 		Sum = 0;
 		Rang = 0;
 		return;
@@ -195,17 +391,52 @@ private:
 	double Min = 0;
 
 	UPROPERTY()
-	double LastMin = 0;
+	double Max = 0;
 
 	UPROPERTY()
-	double Max = 0;
+	double Median = 0;
 
+	// population variance
 	UPROPERTY()
-	double LastMax = 0;
+	double Variance = 0;
+
+	UPROPERTY()
+	double StandardDeviation = 0;
+
+	UPROPERTY()
+	double Skewness = 0;
 
 	UPROPERTY()
 	FDateTime LastUpdate = FDateTime::MinValue();
 
+	// all values, not replicated - clients receive Min, Max and Median
+	FBA_FOrderStatistics OrderStatistics;
+
+	// online moments behind Mean, Variance and Skewness (server only)
+	FBA_FMoments Moments;
+
+	bool bCompensatedSum = false;
+
+	FBA_FCompensatedSum CompensatedSum;
+
+	// removals since the moments were last recomputed from OrderStatistics
+	int64 RemovalsSinceRecompute = 0;
+
+	UPROPERTY()
+	bool bSketches = false;
+
+	// bounded summary of the values for quantiles on clients
+	UPROPERTY()
+	FBA_FQuantileSketch QuantileSketch;
+
+	UPROPERTY()
+	FBA_FHistogram Histogram;
+
+	int32 HistogramBinCount = 32;
+
+	// removals and out of range values since the last rebuild (server only)
+	int64 PendingSketchRebuild = 0;
+
 #pragma endregion
 
 };
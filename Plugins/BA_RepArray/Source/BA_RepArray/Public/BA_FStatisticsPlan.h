@@ -0,0 +1,74 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "Math/NumericLimits.h"
+
+/**
+* Numeric properties of one type as read by the statistics: offset, value kind and position in the statistics array.
+* Compiled once per type, so adding an entry is a loop of typed loads without property iteration or name lookups.
+*/
+struct BA_REPARRAY_API FBA_FStatisticsPlan
+{
+public:
+
+	enum class EValueKind : uint8
+	{
+		Int8,
+		Int16,
+		Int32,
+		Int64,
+		UInt8,
+		UInt16,
+		UInt32,
+		UInt64,
+		Float,
+		Double,
+	};
+
+	struct FStep
+	{
+		const FNumericProperty* Property = nullptr;
+		int32 Offset = 0;
+		EValueKind Kind = EValueKind::Double;
+		int32 StatPosition = INDEX_NONE;
+	};
+
+	// FindOrAddStatistics returns the statistics position of a property, properties without a valid position are skipped
+	void Compile(const UStruct* Type, TFunctionRef<int32(const FProperty*)> FindOrAddStatistics);
+
+	const TArray<FStep>& GetSteps() const { return Steps; }
+
+	// false for values the statistics ignore, same rule as ABA_ReplicationInfo::GetStatisticsValueFromPtr
+	static FORCEINLINE bool ReadValue(const FStep& Step, const void* Container, double& OutValue)
+	{
+		const uint8* ValuePtr = static_cast<const uint8*>(Container) + Step.Offset;
+		double Value;
+		switch (Step.Kind)
+		{
+		case EValueKind::Int8:   Value = *reinterpret_cast<const int8*>(ValuePtr); break;
+		case EValueKind::Int16:  Value = *reinterpret_cast<const int16*>(ValuePtr); break;
+		case EValueKind::Int32:  Value = *reinterpret_cast<const int32*>(ValuePtr); break;
+		case EValueKind::Int64:  Value = static_cast<double>(*reinterpret_cast<const int64*>(ValuePtr)); break;
+		case EValueKind::UInt8:  Value = *ValuePtr; break;
+		case EValueKind::UInt16: Value = *reinterpret_cast<const uint16*>(ValuePtr); break;
+		case EValueKind::UInt32: Value = *reinterpret_cast<const uint32*>(ValuePtr); break;
+		case EValueKind::UInt64: Value = static_cast<double>(*reinterpret_cast<const uint64*>(ValuePtr)); break;
+		case EValueKind::Float:  Value = *reinterpret_cast<const float*>(ValuePtr); break;
+		default:                 Value = *reinterpret_cast<const double*>(ValuePtr); break;
+		}
+		if (Value > TNumericLimits<double>::Min())
+		{
+			OutValue = Value;
+			return true;
+		}
+		return false;
+	}
+
+private:
+
+	static bool GetValueKind(const FNumericProperty* Property, EValueKind& OutKind);
+
+	TArray<FStep> Steps;
+};
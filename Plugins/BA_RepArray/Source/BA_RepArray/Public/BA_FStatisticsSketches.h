@@ -0,0 +1,97 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "BA_FStatisticsSketches.generated.h"
+
+/**
+* KLL quantile sketch: bounded memory (about 3 * K values), mergeable, rank error about 1.7 / K.
+* Levels are stored in one array from the top level down to level 0, so adding a value appends it.
+* Values are kept as float to replicate compactly. Deletions are not supported, the owner rebuilds the sketch instead.
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FQuantileSketch
+{
+	GENERATED_BODY()
+
+public:
+
+	FBA_FQuantileSketch() = default;
+	explicit FBA_FQuantileSketch(int32 InK) : K(FMath::Max(InK, 8)) { }
+
+	void Add(double Value);
+
+	// adds all values of Other, the result has the accuracy of the smaller K
+	void Merge(const FBA_FQuantileSketch& Other);
+
+	void Reset();
+
+	// Fraction between 0 and 1, false if the sketch is empty
+	bool GetQuantile(double Fraction, double& OutValue) const;
+
+	// number of values added
+	int64 Num() const { return Count; }
+
+	int32 NumRetained() const { return Items.Num(); }
+
+private:
+
+	int32 Capacity(int32 Level) const;
+	int32 LevelOffset(int32 Level) const;
+	void CompressIfNeeded();
+	void CompressLevel(int32 Level);
+
+	UPROPERTY()
+	int32 K = 200;
+
+	UPROPERTY()
+	int64 Count = 0;
+
+	// all retained values, top level first
+	UPROPERTY()
+	TArray<float> Items;
+
+	// number of retained values per level, level 0 first
+	UPROPERTY()
+	TArray<int32> LevelSizes;
+
+	// xorshift state for choosing the surviving half
+	uint32 Seed = 2463534242u;
+};
+
+/**
+* Histogram with a fixed number of equally wide bins over [RangeMin, RangeMax], values outside are counted in the edge bins.
+* Supports exact removal as long as the range is unchanged, the owner rebuilds it with a new range.
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FHistogram
+{
+	GENERATED_BODY()
+
+public:
+
+	void Reset(int32 NumBins, double InRangeMin, double InRangeMax);
+
+	// false if Value is outside of the range and was counted in an edge bin
+	bool Add(double Value);
+
+	void Remove(double Value);
+
+	double GetRangeMin() const { return RangeMin; }
+	double GetRangeMax() const { return RangeMax; }
+	const TArray<int32>& GetBins() const { return Bins; }
+
+private:
+
+	int32 GetBin(double Value) const;
+
+	UPROPERTY()
+	double RangeMin = 0;
+
+	UPROPERTY()
+	double RangeMax = 0;
+
+	UPROPERTY()
+	TArray<int32> Bins;
+};
@@ -13,7 +13,11 @@
 #include "Logging/StructuredLog.h"
 #include "BA_RepArray.h"
 #include "BA_FStatistics.h"
+#include "BA_FStatisticsPlan.h"
+#include "UObject/ObjectKey.h"
+#include "BA_FObjectCache.h"
 #include "FFAStructs/FBA_FFA_ObjectArray.h"
+#include "FFAStructs/FBA_FPageCursor.h"
 #include "BA_Statics.h"
 #include "BA_ReplicationInfo.generated.h"
 
@@ -95,6 +99,28 @@ public:
         , CompactNodeTitle = "Get All Objects"))
     TMap<FGuid, UObject*> GetArrayObjects();
 
+    /**
+     * Retrieves all objects of one class from the Replication Array.
+     *
+     * @param Class The exact class of the objects to retrieve (no child classes).
+     * @return Returns a map where each entry consists of a GUID key and a UObject* value.
+     * @note Entries are matched by their class index, so objects of other classes are not deserialized.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get all Objects of one Class from the Replication Array."
+        , ShortToolTip = "Get Objects Of Class", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Get Objects Of Class"))
+    TMap<FGuid, UObject*> GetArrayObjectsOfClass(UClass* Class);
+
+    /**
+     * Retrieves all classes stored in the Replication Array.
+     *
+     * @return Returns the class table of the array, ordered by class index.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get all Classes stored in the Replication Array."
+        , ShortToolTip = "Get Entry Classes", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Get Entry Classes"))
+    TArray<UClass*> GetEntryClasses() const;
+
     /**
     * Retrieves an object by its instance GUID.
     *
@@ -132,6 +158,57 @@ public:
         , CompactNodeTitle = "Object By Id"))
     void GetObjectByIdentifier(FString Identifier, bool& Found, UObject*& ObjectFound);
 
+    /**
+    * Retrieves the readable identifier of an entry without deserializing it.
+    *
+    * @param Guid The unique identifier of the entry.
+    * @param Found This will be set to true if the entry is found, otherwise false.
+    * @param InstanceIdentifier The readable identifier, the guid as string for guid based identifiers.
+    */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Entry Identifier. Returns the readable identifier of an entry."
+        , ShortToolTip = "Entry Identifier", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Entry Identifier"))
+    void GetEntryIdentifier(FGuid Guid, bool& Found, FString& InstanceIdentifier);
+
+    /**
+    * Returns the readable identifier of an entry struct, e.g. as received by the OnEntryPostReplicated events.
+    * The identifier is stored compactly in the entry and cannot be read by breaking the struct.
+    *
+    * @param Entry The entry.
+    */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Readable Identifier. Returns the readable identifier of an entry struct."
+        , ShortToolTip = "Readable Identifier", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Readable Identifier"))
+    static FString GetReadableIdentifier(const FBA_FFA_Object& Entry);
+
+    /**
+    * Retrieves the handle of an entry. Handles stay valid while the entry exists and are resolved without hashing,
+    * they are local to the server or client and must not be sent over the network.
+    *
+    * @param Guid The unique identifier of the entry.
+    * @param Found This will be set to true if the entry is found, otherwise false.
+    * @param Handle The handle of the entry.
+    * @note This function is callable from Blueprints and does not modify the state of the object (BlueprintPure).
+    */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Entry Handle. Handles are resolved faster than Guids, but are only valid on the machine that issued them."
+        , ShortToolTip = "Entry Handle", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Entry Handle"))
+    void GetEntryHandle(FGuid Guid, bool& Found, FBA_FEntryHandle& Handle);
+
+    /**
+    * Retrieves an object by its entry handle.
+    *
+    * @param Handle The handle of the entry, see GetEntryHandle.
+    * @param Found This will be set to true if the entry still exists, otherwise false.
+    * @param ObjectFound A reference to a pointer of the UObject that was found.
+    * @param InstanceGuid The unique identifier of the entry.
+    * @note This function is callable from Blueprints and does not modify the state of the object (BlueprintPure).
+    */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Object by its Entry Handle."
+        , ShortToolTip = "Object By Handle", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Object By Handle"))
+    void GetObjectByHandle(FBA_FEntryHandle Handle, bool& Found, UObject*& ObjectFound, FGuid& InstanceGuid);
+
     /**
      * Retrieves a random entry from the Replication Array.
      *
@@ -151,6 +228,46 @@ public:
         , CompactNodeTitle = "Random Entry"))
     void GetRandomEntry(bool& Found, UObject*& ObjectFound, FGuid& InstanceGuid, FString& InstanceIdentifier);
 
+    /**
+     * Brings an object previously received from this array up to date without creating a new object.
+     * If the payload revision is unchanged only the properties changed after KnownPatchRevision are applied,
+     * otherwise the object is reloaded in place.
+     *
+     * @param Guid The unique identifier of the entry.
+     * @param Object The object to refresh, must be of the entry class.
+     * @param KnownPayloadRevision Payload revision of the entry when Object was received.
+     * @param KnownPatchRevision Patch revision of the entry when Object was received.
+     * @param Refreshed This will be set to true if the object was refreshed.
+     * @param PayloadRevision Current payload revision of the entry.
+     * @param PatchRevision Current patch revision of the entry.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Refresh Object. Applies the changes of an entry to an object previously received from this array, without creating a new object."
+        , ShortToolTip = "Refresh Object", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Refresh Object"))
+    void RefreshObjectFromEntry(FGuid Guid, UObject* Object, int32 KnownPayloadRevision, int32 KnownPatchRevision, bool& Refreshed, int32& PayloadRevision, int32& PatchRevision);
+
+    /**
+     * Retrieves a struct entry by its instance GUID. No object is created.
+     *
+     * @param Guid The unique identifier of the struct entry to retrieve.
+     * @param Found This will be set to true if a struct entry of the connected struct type is found, otherwise false.
+     * @param OutStruct The struct the entry is copied to, its type needs to match the stored struct.
+     */
+    UFUNCTION(BlueprintCallable, CustomThunk, meta = (ToolTip = "Get Struct by its Instance Guid. The struct type connected needs to match the stored struct."
+        , ShortToolTip = "Struct By Guid", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Struct By Guid", CustomStructureParam = "OutStruct"))
+    void GetStructByGuid(FGuid Guid, bool& Found, int32& OutStruct);
+    DECLARE_FUNCTION(execGetStructByGuid);
+
+    // native version of GetStructByGuid
+    bool GetStructEntry(FGuid Guid, const UScriptStruct* StructType, void* OutStructData);
+
+    template<typename T>
+    bool GetStructEntry(FGuid Guid, T& OutStruct)
+    {
+        return GetStructEntry(Guid, T::StaticStruct(), &OutStruct);
+    }
+
 #pragma region Sorting & Filtering
 
     /**
@@ -182,6 +299,319 @@ public:
         , CompactNodeTitle = "Sort By Property"))
     void SortByObjectPropertyName(FString PropertyName);
 
+    /**
+     * Creates a named sorted view. Views keep their own order of the entries and are updated on every add, remove and change,
+     * the array itself is not reordered, so nothing is replicated. Every client can have its own views.
+     *
+     * @param ViewName Name of the view, an existing view with this name is replaced.
+     * @param PropertyName Property to sort by, empty sorts by the index the entries were added with.
+     * @param bDescending Sort from the highest to the lowest value.
+     * @return Returns true if the view was created.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Create Sorted View. Keeps a local sort order of the entries without reordering or replicating the array."
+        , ShortToolTip = "Create Sorted View", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Create Sorted View"))
+    bool CreateSortedView(FName ViewName, FString PropertyName, bool bDescending = false);
+
+    /**
+     * Removes a sorted view.
+     *
+     * @param ViewName Name of the view.
+     * @return Returns true if the view existed.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Remove Sorted View."
+        , ShortToolTip = "Remove Sorted View", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Remove Sorted View"))
+    bool RemoveSortedView(FName ViewName);
+
+    /**
+     * Retrieves the objects of a sorted view in the order of the view.
+     *
+     * @param ViewName Name of the view.
+     * @param Found This will be set to true if the view exists.
+     * @param Objects The objects in view order.
+     * @param InstanceGuids The unique identifiers of the objects, aligned with Objects.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Sorted View. Returns the objects in the order of a sorted view."
+        , ShortToolTip = "Sorted View", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Sorted View"))
+    void GetSortedView(FName ViewName, bool& Found, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Creates a local index on a property. The index maps the values of the property to the entries having them
+     * and is updated on every add, remove and change, so lookups with FindEntriesByValue do not deserialize any entry.
+     * Indexes listed in IndexedProperties (config) are created automatically.
+     *
+     * @param PropertyName Name of the property of the stored classes or structs.
+     * @return Returns true if the index exists.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Add Property Index. Indexes the values of a property for fast lookups with Find Entries By Value."
+        , ShortToolTip = "Add Property Index", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Add Property Index"))
+    bool AddPropertyIndex(FName PropertyName);
+
+    /**
+     * Removes a property index.
+     *
+     * @param PropertyName Name of the indexed property.
+     * @return Returns true if the index existed.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Remove Property Index."
+        , ShortToolTip = "Remove Property Index", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Remove Property Index"))
+    bool RemovePropertyIndex(FName PropertyName);
+
+    /**
+     * Finds all entries whose indexed property has a value. Only the index is read, no payload is deserialized.
+     *
+     * @param PropertyName Name of the indexed property.
+     * @param Value The value as text: numbers, true/false, strings, names or the name of an enum value.
+     * @param IndexFound This will be set to true if PropertyName is indexed.
+     * @param InstanceGuids The unique identifiers of the matching entries (unordered).
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Find Entries By Value. Looks up the entries with a value of an indexed property."
+        , ShortToolTip = "Find By Value", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Find By Value"))
+    void FindEntriesByValue(FName PropertyName, FString Value, bool& IndexFound, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Creates a local ordered index on a numeric property (the properties statistics are calculated for).
+     * Used by FindEntriesInRange and GetEntriesByRank, updated on every add, remove and change.
+     * Indexes listed in RangeIndexedProperties (config) are created automatically.
+     *
+     * @param PropertyName Name of the numeric property of the stored classes or structs.
+     * @return Returns true if the index exists.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Add Range Index. Orders the entries by a numeric property for range and rank queries."
+        , ShortToolTip = "Add Range Index", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Add Range Index"))
+    bool AddRangeIndex(FName PropertyName);
+
+    /**
+     * Removes a range index.
+     *
+     * @param PropertyName Name of the indexed property.
+     * @return Returns true if the index existed.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Remove Range Index."
+        , ShortToolTip = "Remove Range Index", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Remove Range Index"))
+    bool RemoveRangeIndex(FName PropertyName);
+
+    /**
+     * Finds the entries with Min <= value <= Max of a range indexed property, ordered by the value.
+     *
+     * @param PropertyName Name of the indexed property.
+     * @param Min Lowest value included.
+     * @param Max Highest value included.
+     * @param MaxCount Maximum number of results, 0 returns all.
+     * @param IndexFound This will be set to true if PropertyName has a range index.
+     * @param InstanceGuids The unique identifiers of the matching entries in ascending order of the value.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Find Entries In Range. Returns the entries with a value of a range indexed property between Min and Max."
+        , ShortToolTip = "Find In Range", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Find In Range"))
+    void FindEntriesInRange(FName PropertyName, double Min, double Max, int32 MaxCount, bool& IndexFound, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Returns the entries at a range of ranks of a range indexed property, e.g. First = 0 and Count = 20 returns the 20 lowest values.
+     *
+     * @param PropertyName Name of the indexed property.
+     * @param First Rank of the first entry, 0 is the lowest value (highest if bDescending).
+     * @param Count Number of entries.
+     * @param bDescending Rank from the highest to the lowest value.
+     * @param IndexFound This will be set to true if PropertyName has a range index.
+     * @param InstanceGuids The unique identifiers of the entries in rank order.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Entries By Rank. Returns the entries with the lowest or highest values of a range indexed property."
+        , ShortToolTip = "Get By Rank", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Get By Rank"))
+    void GetEntriesByRank(FName PropertyName, int32 First, int32 Count, bool bDescending, bool& IndexFound, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Creates a named filtered view. Every entry is either E_Filtered_Visible or E_Filtered_InVisible, the status is
+     * updated per entry on every add, remove and change (also from replication), the query is not evaluated again for all entries.
+     *
+     * @param ViewName Name of the view, an existing view with this name is replaced.
+     * @param Query Clauses combined with OR, each clause combines its predicates with AND. An empty query shows all entries.
+     * @return Returns true if the view was created.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Create Filtered View. Keeps the entries matching a query up to date without reordering or replicating the array."
+        , ShortToolTip = "Create Filtered View", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Create Filtered View"))
+    bool CreateFilteredView(FName ViewName, const FBA_FQuery& Query);
+
+    /**
+     * Removes a filtered view.
+     *
+     * @param ViewName Name of the view.
+     * @return Returns true if the view existed.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Remove Filtered View."
+        , ShortToolTip = "Remove Filtered View", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Remove Filtered View"))
+    bool RemoveFilteredView(FName ViewName);
+
+    /**
+     * Retrieves the visible objects of a filtered view in the order of the array.
+     *
+     * @param ViewName Name of the view.
+     * @param Found This will be set to true if the view exists.
+     * @param Objects The visible objects.
+     * @param InstanceGuids The unique identifiers of the objects, aligned with Objects.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Filtered View. Returns the objects matching the query of a filtered view."
+        , ShortToolTip = "Filtered View", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Filtered View"))
+    void GetFilteredView(FName ViewName, bool& Found, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Returns the status of an entry in a filtered view.
+     *
+     * @param ViewName Name of the view.
+     * @param Guid The unique identifier of the entry.
+     * @return E_Filtered_Visible or E_Filtered_InVisible, E_UNDEFINED if the view or the entry does not exist.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Entry Filter Status. Returns if an entry is visible in a filtered view."
+        , ShortToolTip = "Filter Status", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Filter Status"))
+    EBA_EEntryStatus GetEntryFilterStatus(FName ViewName, FGuid Guid);
+
+    /**
+     * Calculates an aggregate of a numeric property over all entries or the visible entries of a filtered view.
+     * With bNumericColumns (config) the values are read from contiguous columns with vectorized kernels, otherwise every entry is read.
+     *
+     * @param PropertyName Name of the numeric property.
+     * @param Op Sum, min, max, mean, count or count above Threshold.
+     * @param FilterViewName Filtered view, None aggregates all entries. Use a class predicate for aggregates by class.
+     * @param Threshold Used by E_CountAbove.
+     * @param Result The aggregate, 0 if no entry has the property.
+     * @param Count Number of values aggregated.
+     * @return Returns false if FilterViewName does not exist.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Aggregate. Sum, min, max, mean or count of a numeric property over all or the filtered entries."
+        , ShortToolTip = "Aggregate", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Aggregate"))
+    bool Aggregate(FName PropertyName, EBA_EAggregateOp Op, FName FilterViewName, double Threshold, double& Result, int32& Count);
+
+#pragma endregion
+
+#pragma region Paging
+
+    /**
+     * Retrieves one page of the array, a sorted view or a filtered view. Only the objects of the page are deserialized.
+     *
+     * @param Offset Position of the first entry in the view.
+     * @param Count Number of entries of the page.
+     * @param ViewName Sorted or filtered view, None pages through the array order.
+     * @param bPrefetchNextPage Deserializes the following page into the object cache on the next tick (needs MaxCachedObjects in config).
+     * @param Found This will be set to true if the view exists.
+     * @param TotalCount Number of entries in the view.
+     * @param Objects The objects of the page in view order.
+     * @param InstanceGuids The unique identifiers of the objects, aligned with Objects.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Get Page. Returns a window of the array or a view, only the returned objects are deserialized."
+        , ShortToolTip = "Get Page", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Get Page"))
+    void GetPage(int32 Offset, int32 Count, FName ViewName, bool bPrefetchNextPage, bool& Found, int32& TotalCount, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Creates a cursor to read the array or a view page by page with NextPage.
+     * Without a sorted view the cursor pages in a stable internal order, not in the array order of GetPage.
+     *
+     * @param ViewName Sorted or filtered view, None pages through the array order.
+     * @param PageSize Number of entries per page.
+     * @param Offset Position of the first entry.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Make Page Cursor. Creates a cursor for Next Page."
+        , ShortToolTip = "Make Page Cursor", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Make Page Cursor"))
+    FBA_FPageCursor MakePageCursor(FName ViewName, int32 PageSize, int32 Offset = 0);
+
+    /**
+     * Retrieves the next page of a cursor and advances it. The page continues after the last entry returned before,
+     * so removed entries do not cause skipped or repeated entries. Entries added while paging may be returned or not.
+     * For sorted views this holds as long as the last returned entry still exists, otherwise the cursor continues at its offset.
+     *
+     * @param Cursor The cursor, see MakePageCursor.
+     * @param bPrefetchNextPage Deserializes the following page into the object cache on the next tick (needs MaxCachedObjects in config).
+     * @param Objects The objects of the page in view order.
+     * @param InstanceGuids The unique identifiers of the objects, aligned with Objects.
+     * @return Returns false if there are no more entries or the view does not exist.
+     */
+    UFUNCTION(BlueprintCallable, meta = (ToolTip = "Next Page. Returns the next page of a cursor and advances it."
+        , ShortToolTip = "Next Page", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Next Page"))
+    bool NextPage(UPARAM(ref) FBA_FPageCursor& Cursor, bool bPrefetchNextPage, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids);
+
+#pragma endregion
+
+#pragma region Statistics
+
+    /**
+     * Retrieves the exact minimum, maximum and median of a numeric property over all entries.
+     *
+     * @param PropertyName Name of the numeric property.
+     * @param Found This will be set to true if statistics exist for the property.
+     * @note Min, Max and Median are replicated, so this works on clients too.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Statistics Order Values. Returns min, max and median of a numeric property."
+        , ShortToolTip = "Statistics Min Max Median", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Min Max Median"))
+    void GetStatisticsOrderValues(FName PropertyName, bool& Found, double& Min, double& Max, double& Median);
+
+    /**
+     * Retrieves mean, population variance, standard deviation and skewness of a numeric property over all entries.
+     * They are updated online with every add and remove, so they stay accurate for long-lived arrays.
+     *
+     * @param PropertyName Name of the numeric property.
+     * @param Found This will be set to true if statistics exist for the property.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Statistics Moments. Returns mean, variance, standard deviation and skewness of a numeric property."
+        , ShortToolTip = "Statistics Moments", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Moments"))
+    void GetStatisticsMoments(FName PropertyName, bool& Found, double& Mean, double& Variance, double& StandardDeviation, double& Skewness);
+
+    /**
+     * Retrieves the k-th smallest value of a numeric property over all entries in O(log n).
+     *
+     * @param PropertyName Name of the numeric property.
+     * @param K Zero based rank, 0 is the minimum.
+     * @param Value The k-th smallest value.
+     * @return Returns false if K is out of range or the values are not available (clients only receive min, max and median).
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Statistics Kth Smallest. Returns the value at a rank of a numeric property."
+        , ShortToolTip = "Kth Smallest", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Kth Smallest"))
+    bool GetStatisticsKthSmallest(FName PropertyName, int32 K, double& Value);
+
+    /**
+     * Retrieves quantiles of a numeric property, e.g. 0.5, 0.9 and 0.99 for p50, p90 and p99.
+     * Exact on the server, clients estimate them from the replicated quantile sketch (bStatisticsSketches in config).
+     *
+     * @param PropertyName Name of the numeric property.
+     * @param Fractions Quantiles between 0 and 1.
+     * @param Found This will be set to true if the quantiles could be calculated.
+     * @param Values The quantile values, aligned with Fractions.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Statistics Quantiles. Returns quantiles (e.g. p50, p90, p99) of a numeric property."
+        , ShortToolTip = "Statistics Quantiles", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Quantiles"))
+    void GetStatisticsQuantiles(FName PropertyName, const TArray<double>& Fractions, bool& Found, TArray<double>& Values);
+
+    /**
+     * Retrieves the replicated histogram of a numeric property (bStatisticsSketches in config).
+     * The bins have equal width between RangeMin and RangeMax.
+     *
+     * @param PropertyName Name of the numeric property.
+     * @param Found This will be set to true if a histogram exists for the property.
+     * @param Bins Number of values per bin.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Statistics Histogram. Returns the histogram of a numeric property."
+        , ShortToolTip = "Statistics Histogram", Category = "BA Rep Array|Replication Info Actor|Non Authoritive Functions"
+        , CompactNodeTitle = "Histogram"))
+    void GetStatisticsHistogram(FName PropertyName, bool& Found, double& RangeMin, double& RangeMax, TArray<int32>& Bins);
+
 #pragma endregion
 
 #pragma endregion
@@ -205,6 +635,44 @@ public:
         , CompactNodeTitle = "Add Object"))
     void AddObject(UObject* StorageObject, bool& SuccessfullyAdded, FGuid& InstanceGuid, FString& InstanceIdentifier, int64 NumberOfNewObject = 1);
 
+    /**
+     * Adds several objects to the Replication Array in one batch.
+     * The array is updated in one pass and the statistics are updated once per class property.
+     *
+     * @param StorageObjects The objects to add.
+     * @param NumberAdded Number of objects that were successfully added.
+     * @param InstanceGuids Guids of the new entries in the order of StorageObjects, invalid for objects that could not be added.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, meta = (ToolTip = "Add several Objects to a Replication Array in one batch. Returns the Guids in the order of the provided objects (invalid Guid if an object could not be added). Warning: Do not add more objects than the data channel can transport (default is 64kB) within one adding process"
+        , ShortToolTip = "Add Objects", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
+        , CompactNodeTitle = "Add Objects"))
+    void AddObjects(const TArray<UObject*>& StorageObjects, int32& NumberAdded, TArray<FGuid>& InstanceGuids);
+
+    /**
+     * Adds a struct to the Replication Array. Struct entries are stored and read without creating a UObject.
+     *
+     * @param StorageStruct The struct to store, any Blueprint or native struct.
+     * @param SuccessfullyAdded This will be set to true if the struct was successfully added.
+     * @param InstanceGuid The unique identifier for the entry that was added.
+     * @param InstanceIdentifier A string identifier for the entry.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, CustomThunk, meta = (ToolTip = "Add Struct to a Replication Array. Struct entries are read without creating objects."
+        , ShortToolTip = "Add Struct", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
+        , CompactNodeTitle = "Add Struct", CustomStructureParam = "StorageStruct"))
+    void AddStruct(const int32& StorageStruct, bool& SuccessfullyAdded, FGuid& InstanceGuid, FString& InstanceIdentifier);
+    DECLARE_FUNCTION(execAddStruct);
+
+    // native version of AddStruct
+    bool AddStructEntry(const UScriptStruct* StructType, const void* StructData, FGuid& InstanceGuid, FString& InstanceIdentifier);
+
+    template<typename T>
+    bool AddStructEntry(const T& StorageStruct, FGuid& InstanceGuid, FString& InstanceIdentifier)
+    {
+        return AddStructEntry(T::StaticStruct(), &StorageStruct, InstanceGuid, InstanceIdentifier);
+    }
+
     /**
      * Clears all elements from the array.
      *
@@ -227,6 +695,96 @@ public:
         , ShortToolTip = "Delete Entry", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
         , CompactNodeTitle = "Delete Entry"))
     bool RemoveEntry(FGuid Guid, UObject*& DeletedEntry);
+
+    /**
+     * Removes several entries in one pass. The removed entries are not deserialized.
+     *
+     * @param Guids The unique identifiers of the entries to be removed.
+     * @return Returns the number of entries removed.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, meta = (ToolTip = "Delete several Entries from Replication Array in one pass."
+        , ShortToolTip = "Delete Entries", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
+        , CompactNodeTitle = "Delete Entries"))
+    int32 RemoveEntries(const TArray<FGuid>& Guids);
+
+    /**
+     * Updates an existing entry with the property values of a modified object of the same class.
+     * With property delta replication enabled only the changed properties are stored and replicated,
+     * otherwise the full payload of the entry is replaced.
+     *
+     * @param Guid The unique identifier of the entry to be updated.
+     * @param ModifiedObject Object holding the new property values, must be of the entry class.
+     * @param Updated This will be set to true if the entry was found and updated.
+     * @param ChangedProperties Names of all properties that differ from the stored entry.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, meta = (ToolTip = "Update Entry Properties. Stores the changed properties of a modified object in an existing entry. With property delta replication only the changed properties are replicated."
+        , ShortToolTip = "Update Entry Properties", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
+        , CompactNodeTitle = "Update Entry Properties"))
+    void UpdateEntryProperties(FGuid Guid, UObject* ModifiedObject, bool& Updated, TArray<FName>& ChangedProperties);
+
+    /**
+     * Updates an existing entry in place, the Guid and identifier stay the same.
+     * Clients receive a single change of the entry, the statistics are only updated for changed values.
+     *
+     * @param Guid The unique identifier of the entry to be updated.
+     * @param ModifiedObject Object holding the new property values, must be of the entry class.
+     * @return Returns true if the entry was found and updated.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, meta = (ToolTip = "Update Entry in place. The Guid and identifier of the entry stay the same."
+        , ShortToolTip = "Update Entry", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
+        , CompactNodeTitle = "Update Entry"))
+    bool UpdateEntry(FGuid Guid, UObject* ModifiedObject);
+
+    /**
+     * Sets a single property of an existing entry (object or struct entry) in place.
+     *
+     * @param Guid The unique identifier of the entry to be updated.
+     * @param PropertyName Name of the property in the entry class or struct.
+     * @param Value The new value, must be of the same type as the property.
+     * @param Updated This will be set to true if the property was found and set.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, CustomThunk, meta = (ToolTip = "Set a single Property of an Entry in place. The value must be of the same type as the property."
+        , ShortToolTip = "Set Entry Property", Category = "BA Rep Array|Replication Info Actor|Array CRUD"
+        , CompactNodeTitle = "Set Entry Property", CustomStructureParam = "Value"))
+    void SetEntryProperty(FGuid Guid, FName PropertyName, const int32& Value, bool& Updated);
+    DECLARE_FUNCTION(execSetEntryProperty);
+
+    // native version of SetEntryProperty, ValueProperty describes the memory at Value
+    bool SetEntryPropertyValue(FGuid Guid, FName PropertyName, const FProperty* ValueProperty, const void* Value);
+#pragma endregion
+
+#pragma region Payload Settings
+
+    /**
+     * Sets the payload format used for new entries and migrates all existing entries to it.
+     * Existing payloads are converted without deserializing the stored objects.
+     *
+     * @param NewPayloadFormat The payload format to use from now on.
+     * @return Returns the number of entries that were migrated.
+     * @note This function is callable from Blueprints and is only authoritative on the server.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, meta = (ToolTip = "Set Payload Format. Sets the storage format for new entries and migrates all existing entries to it. Warning: every migrated entry is replicated again."
+        , ShortToolTip = "Set Payload Format", Category = "BA Rep Array|Replication Info Actor|Payload"
+        , CompactNodeTitle = "Set Payload Format"))
+    int32 SetPayloadFormat(EBA_EPayloadFormat NewPayloadFormat);
+
+    /**
+     * Retrieves the payload format used for new entries.
+     *
+     * @return Returns the current payload format.
+     */
+    UFUNCTION(BlueprintCallable, BlueprintPure, meta = (ToolTip = "Get Payload Format. Returns the storage format used for new entries."
+        , ShortToolTip = "Get Payload Format", Category = "BA Rep Array|Replication Info Actor|Payload"
+        , CompactNodeTitle = "Get Payload Format"))
+    EBA_EPayloadFormat GetPayloadFormat() const
+    {
+        return PayloadFormat;
+    }
+
 #pragma endregion
 
 #pragma endregion
@@ -270,7 +828,7 @@ public:
     FString DumpStatisticsProperties()
     {
         FString StatisticsResult;
-        for (FBA_FStatistics Stat : StatisticsArray)
+        for (FBA_FStatistics& Stat : StatisticsArray)
         {
             StatisticsResult += Stat.ToString() + LINE_TERMINATOR;
         }
@@ -319,6 +877,11 @@ public:
 
 #pragma endregion
 
+#pragma region Overrides
+    virtual void PostInitProperties() override;
+    virtual void BeginDestroy() override;
+#pragma endregion
+
 #pragma region Networking & Replication
     void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const;
     virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
@@ -326,25 +889,105 @@ public:
 
 private:
 
-    void UpdateStatistics_Add(UObject* Object);
-    void UpdateStatistics_Remove(UObject* Object);
+    void UpdateStatistics_Add(const FGuid& Guid, UObject* Object);
+    // container based version, used for struct entries
+    void UpdateStatistics_Add(const FGuid& Guid, const UStruct* Type, const void* Container);
+    // removes the values recorded for the entry when it was added
+    void UpdateStatistics_Remove(const FGuid& Guid);
+    // replaces the recorded values of the entry with the values of Container, only changed values touch the statistics
+    void UpdateStatistics_Change(const FGuid& Guid, const UStruct* Type, const void* Container);
+    // unset NewValue removes the recorded value of Property
+    void UpdateStatistics_Change(const FGuid& Guid, const FProperty* Property, TOptional<double> NewValue);
+    // same for the statistics at Position in StatisticsArray
+    void UpdateStatistics_ChangePosition(const FGuid& Guid, int32 Position, TOptional<double> NewValue);
+    // adds all objects with one update per class property, Guids aligned with Objects
+    void UpdateStatistics_AddBatch(const TArray<UObject*>& Objects, const TArray<FGuid>& Guids);
+    // removes all entries with one update per class property
+    void UpdateStatistics_RemoveBatch(const TArray<FGuid>& Guids);
 
 private:
+    // classes of the entries of ReplicatedObjectArray, entries only replicate an index into it
+    UPROPERTY(Replicated)
+    FBA_FClassTable ClassTable;
+
+    // payloads shared by entries of ReplicatedObjectArray, declared first so payloads arrive before the entries referencing them
+    UPROPERTY(Replicated)
+    FBA_FFA_PayloadStore SharedPayloadStore;
+
     UPROPERTY(Replicated)
     FBA_FFA_ObjectArray ReplicatedObjectArray;
 
     UPROPERTY(Replicated)
     TArray<FBA_FStatistics> StatisticsArray;
+
+    // (position in StatisticsArray, value) each entry added to the statistics, so removing needs no deserialization (server only)
+    TMap<FGuid, TArray<TPair<int32, double>>> EntryStatisticsValues;
+
+    // statistics plan per entry type, dropped on hot reload and when the statistics are cleared (server only)
+    TMap<TObjectKey<UStruct>, FBA_FStatisticsPlan> StatisticsPlans;
+
+    // deserialized objects returned by the read functions, reused until their entry changes
+    UPROPERTY(Transient)
+    FBA_FObjectCache ObjectCache;
 	
 	UPROPERTY(Config)
 	TArray<FString> SortableTypesArray;
 
-    UPROPERTY()
-    TArray<FName> Adjectives;
+    // storage format of new entries, see EBA_EPayloadFormat
+    UPROPERTY(Config)
+    EBA_EPayloadFormat PayloadFormat = EBA_EPayloadFormat::E_Binary;
+
+    // compression codec for binary payloads, E_None disables compression
+    UPROPERTY(Config)
+    EBA_ECompressionCodec PayloadCompressionCodec = EBA_ECompressionCodec::E_None;
+
+    // binary payloads smaller than this (in bytes) are stored uncompressed
+    UPROPERTY(Config)
+    int32 PayloadCompressionThreshold = 256;
+
+    // store identical binary payloads (e.g. from AddObject with NumberOfNewObjects > 1) only once
+    UPROPERTY(Config)
+    bool bSharePayloads = false;
+
+    // number of deserialized objects kept for repeated reads, 0 disables the cache (opt-in, getters then return shared objects)
+    UPROPERTY(Config)
+    int32 MaxCachedObjects = 0;
+
+    // replicate only the changed properties of updated entries, needs to be identical on server and clients
+    UPROPERTY(Config)
+    bool bPropertyDeltaReplication = false;
+
+    // property changes are folded back into the payload once they exceed this fraction of the payload size
+    UPROPERTY(Config)
+    float PropertyPatchRebaseRatio = 0.5f;
+
+    // properties indexed on creation of the actor, see AddPropertyIndex
+    UPROPERTY(Config)
+    TArray<FName> IndexedProperties;
+
+    // numeric properties ordered on creation of the actor, see AddRangeIndex
+    UPROPERTY(Config)
+    TArray<FName> RangeIndexedProperties;
+
+    // keep a column of every numeric property, sorting, range indexes and aggregation read the columns instead of the payloads
+    UPROPERTY(Config)
+    bool bNumericColumns = false;
+
+    // replicate a quantile sketch and a histogram with the statistics of every numeric property
+    UPROPERTY(Config)
+    bool bStatisticsSketches = false;
+
+    // sum the statistics values with rounding error compensation (Neumaier)
+    UPROPERTY(Config)
+    bool bCompensatedStatisticsSum = false;
+
+    // accuracy of the quantile sketches, a sketch keeps about 3 * K values
+    UPROPERTY(Config)
+    int32 StatisticsSketchK = 200;
+
+    UPROPERTY(Config)
+    int32 StatisticsHistogramBins = 32;
 
-    UPROPERTY()
-    TArray<FName> Names;
-    
     UPROPERTY(Replicated)
     FRandomStream RandomStream;
 
@@ -353,10 +996,32 @@ private:
 
 private:
 
-    UFUNCTION()
-    bool LoadFileToArray(FString FileName, TArray<FName>& TargetArray);
+    // random compact identifier from the dictionary, guid based if no dictionary is available
+    FBA_FIdentifier GenerateIdentifier();
+
+    // numeric properties of Type with their statistics positions, compiled on first use
+    const FBA_FStatisticsPlan& GetStatisticsPlan(const UStruct* Type);
+
+    // statistics of a property, nullptr if no value was added for it so far
+    FBA_FStatistics* FindStatistics(FName PropertyName);
+
+    // position of the statistics of a property in StatisticsArray, added if new
+    int32 FindOrAddStatistics(const FProperty* Property);
+
+    // value of a numeric property as used for the statistics
+    static bool GetStatisticsValueFromPtr(const FProperty* Property, const void* ValuePtr, double& PropertyValue);
+
+    // guids of the live entries of Handles
+    void GetGuidsOfHandles(const TArray<FBA_FEntryHandle>& Handles, TArray<FGuid>& InstanceGuids) const;
+
+    // cached objects and guids of the live entries of Handles
+    void GetObjectsOfHandles(const TArray<FBA_FEntryHandle>& Handles, TArray<UObject*>& Objects, TArray<FGuid>& InstanceGuids);
+
+    // deserializes a page into the object cache on the next tick, skipped if the cache cannot hold it next to the current page
+    void PrefetchPage(FName ViewName, int32 Offset, int32 Count, const FBA_FEntryHandle& After, bool bSlotOrder);
 
-    bool CheckObjectPropertyForStatistics(TFieldIterator<FProperty> PropIt, UObject* Object, int32& StatPosition, double& PropertyValue);
+    // returns the cached object of an entry or deserializes (and caches) a new one
+    UObject* GetCachedEntryObject(const FBA_FFA_Object& Entry);
 
     UFUNCTION()
     void GetEntryObject(FGuid Guid, bool& ValidObjectFound, UObject*& ObjectFound, FGuid& InstanceGuid, FString& InstanceIdentifier);
@@ -5,8 +5,9 @@
 #include "UObject/UnrealType.h"
 #include "Serialization/BufferArchive.h"
 #include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
-#include "Compression/CompressedBuffer.h"
+#include "Serialization/StructuredArchive.h"
 #include "Runtime/CoreUObject/Public/UObject/UObjectIterator.h"
 #include "Logging/StructuredLog.h"
 #include "Misc/Parse.h"
@@ -116,105 +117,225 @@ public:
     }
 #pragma endregion
 
-#pragma region Outcommented compression - buggy
-    //static TArray<uint8> SerializeObjectIntoUnit8Array(UObject* ObjectToSerialize, int32& UncompressedSize)
-//{
-//    if (ObjectToSerialize != nullptr)
-//    {
-//        // Create a binary archive to serialize data into a byte array
-//        FBufferArchive BinaryData;
-
-//        // Wrap the binary archive with FObjectAndNameAsStringProxyArchive
-//        FObjectAndNameAsStringProxyArchive Ar(BinaryData, true);
-
-//        // Serialize the UObject
-//        ObjectToSerialize->Serialize(Ar); 
-
-//        // Convert the binary data to a base64 string for storage
-//        FString SerializedObjectData;
-//        SerializedObjectData = FBase64::Encode(BinaryData);
-
-//        auto& CharArray = SerializedObjectData.GetCharArray();
-//        UncompressedSize = CharArray.Num();
-
-//        FName CompressionFormatToUse = NAME_LZ4;
-//        
-//        TArray<uint8> CompressedMemory;
-//        int32 CompressedSizeEstimate = FCompression::CompressMemoryBound(CompressionFormatToUse, CharArray.Num());
-//        CompressedMemory.AddDefaulted(CompressedSizeEstimate);
-
-//        const bool bCompressed = FCompression::CompressMemory(
-//            CompressionFormatToUse,
-//            CompressedMemory.GetData(),
-//            CompressedSizeEstimate,
-//            CharArray.GetData(),
-//            CharArray.Num());
-//        // 
-//        // if the compression results are worse, just store uncompressed data
-//        /*if (!bCompressed || CompressedSizeEstimate >= CharArray.Num())
-//        {
-//            return CharArray;
-//        }
-//        else
-//        {
-//            return CompressedMemory;
-//        }*/
-//        return CompressedMemory;
-//    }
-//    return TArray<uint8>();
-//}
-
-//static UObject* DeserializeObjectFromUint8Array(const TArray<uint8>& CompressedData, int32 UncompressedSize, UObject* Outer)
-//{
-//    if (CompressedData.Num() > 0)
-//    {
-//        // compression format
-//        FName CompressionFormatToUse = NAME_LZ4;
-//        
-//        //FString::ToHexBlob(ToProcess->HexData, CompressedData.GetData(), ToProcess->CompressedSize);
-
-//        TArray<uint8> DestData; 
-//        DestData.Reset(UncompressedSize);
-//        DestData.AddUninitialized(UncompressedSize);
-
-//        // Reader.Serialize(SrcData.GetData(), CompressedSize);
-//        bool bDecompressed = FCompression::UncompressMemory(
-//            NAME_Zlib, 
-//            DestData.GetData(), 
-//            UncompressedSize, 
-//            CompressedData.GetData(), 
-//            CompressedData.Num());
-//        
-//        if (bDecompressed)
-//        {
-//            FString Base64Data = FString::FromBlob(DestData.GetData(), DestData.Num());
-//            TArray<uint8> BinaryData;
-
-//            FBase64::Decode(Base64Data, BinaryData);
-//            FMemoryReader Reader(BinaryData, true);
-
-//            FObjectAndNameAsStringProxyArchive Ar(Reader, true);
-//            UObject* DeserializedObject = NewObject<UObject>(Outer);
-//            if (DeserializedObject)
-//            {
-//                DeserializedObject->Serialize(Ar);
-//                return DeserializedObject;
-//            }
-//        }
-//    }
-
-//    return nullptr;
-//}
+#pragma region Property Table
+    /**
+     * Returns all serializable properties of a class or struct in a stable order (TFieldIterator order).
+     * The position of a property in this table is its per-class property index, which is identical
+     * on server and clients running the same build.
+     */
+    static const TArray<FProperty*>& GetPropertyTable(const UStruct* Type);
 
+    // drops all property tables, call after types were reloaded
+    static void ResetPropertyTables();
+
+    static void WritePropertyValue(const FProperty* Property, const void* Container, TArray<uint8>& OutBytes)
+    {
+        OutBytes.Reset();
+        FMemoryWriter Writer(OutBytes, true);
+        FObjectAndNameAsStringProxyArchive Ar(Writer, true);
+        FStructuredArchiveFromArchive StructuredAr(Ar);
+        FStructuredArchive::FStream Stream = StructuredAr.GetSlot().EnterStream();
+        for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+        {
+            Property->SerializeItem(Stream.EnterElement(), const_cast<void*>(Property->ContainerPtrToValuePtr<void>(Container, ArrayIndex)), nullptr);
+        }
+    }
+
+    // compares every element of static arrays (ArrayDim > 1), not only the first one
+    static bool IsPropertyIdentical(const FProperty* Property, const void* ContainerA, const void* ContainerB)
+    {
+        for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+        {
+            if (!Property->Identical_InContainer(ContainerA, ContainerB, ArrayIndex, PPF_None))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool ReadPropertyValue(const FProperty* Property, void* Container, const TArray<uint8>& Bytes)
+    {
+        FMemoryReader Reader(Bytes, true);
+        FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+        FStructuredArchiveFromArchive StructuredAr(Ar);
+        FStructuredArchive::FStream Stream = StructuredAr.GetSlot().EnterStream();
+        for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+        {
+            Property->SerializeItem(Stream.EnterElement(), Property->ContainerPtrToValuePtr<void>(Container, ArrayIndex), nullptr);
+        }
+        return !Ar.IsError();
+    }
 #pragma endregion
 
-    static FString SerializeObject(UObject* StorageObject)
+#pragma region Serialization
+    static bool SerializeObjectToBytes(UObject* StorageObject, TArray<uint8>& OutBytes)
     {
+        OutBytes.Reset();
         if (StorageObject)
         {
-            FBufferArchive BinaryData;
-            FObjectAndNameAsStringProxyArchive Ar(BinaryData, true);
+            FMemoryWriter Writer(OutBytes, true);
+            FObjectAndNameAsStringProxyArchive Ar(Writer, true);
             StorageObject->Serialize(Ar);
+            return !Ar.IsError() && OutBytes.Num() > 0;
+        }
+        return false;
+    }
+
+    static bool SerializeStructToBytes(const UScriptStruct* StructType, const void* StructData, TArray<uint8>& OutBytes)
+    {
+        OutBytes.Reset();
+        if (StructType && StructData)
+        {
+            FMemoryWriter Writer(OutBytes, true);
+            FObjectAndNameAsStringProxyArchive Ar(Writer, true);
+            const_cast<UScriptStruct*>(StructType)->SerializeItem(Ar, const_cast<void*>(StructData), nullptr);
+            return !Ar.IsError() && OutBytes.Num() > 0;
+        }
+        return false;
+    }
+
+    // reads into already initialized struct memory of StructType, no object is created
+    static bool DeserializeStructFromBytes(const TArray<uint8>& BinaryData, const UScriptStruct* StructType, void* StructData)
+    {
+        if (BinaryData.Num() > 0 && StructType && StructData)
+        {
+            FMemoryReader Reader(BinaryData, true);
+            FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+            const_cast<UScriptStruct*>(StructType)->SerializeItem(Ar, StructData, nullptr);
+            return !Ar.IsError();
+        }
+        return false;
+    }
+
+    static UObject* DeserializeObjectFromBytes(const TArray<uint8>& BinaryData, UObject* Outer, UClass* CastToClass)
+    {
+        if (BinaryData.Num() > 0 && CastToClass)
+        {
+            FMemoryReader Reader(BinaryData, true);
+            FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+            if (UObject* DeserializedObject = NewObject<UObject>(Outer, CastToClass);
+                DeserializedObject)
+            {
+                DeserializedObject->Serialize(Ar);
+                return DeserializedObject;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool DeserializeObjectInPlace(const TArray<uint8>& BinaryData, UObject* TargetObject)
+    {
+        if (BinaryData.Num() > 0 && TargetObject)
+        {
+            FMemoryReader Reader(BinaryData, true);
+            FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+            TargetObject->Serialize(Ar);
+            return !Ar.IsError();
+        }
+        return false;
+    }
+
+    /**
+     * Writes only the properties that differ from the class default object as (packed property index + 1, packed size, value) records,
+     * terminated by a packed 0. An object identical to its defaults results in a single byte.
+     */
+    static bool SerializeObjectDeltaToDefaults(UObject* StorageObject, TArray<uint8>& OutBytes)
+    {
+        OutBytes.Reset();
+        if (!StorageObject)
+        {
+            return false;
+        }
+        const UObject* Defaults = StorageObject->GetClass()->GetDefaultObject();
+        const TArray<FProperty*>& PropertyTable = GetPropertyTable(StorageObject->GetClass());
+
+        FMemoryWriter Writer(OutBytes, true);
+        TArray<uint8> SerializedValue;
+        for (int32 PropertyIndex = 0; PropertyIndex < PropertyTable.Num(); PropertyIndex++)
+        {
+            const FProperty* Property = PropertyTable[PropertyIndex];
+            if (IsPropertyIdentical(Property, StorageObject, Defaults))
+            {
+                continue;
+            }
+            WritePropertyValue(Property, StorageObject, SerializedValue);
+            uint32 PackedIndex = PropertyIndex + 1;
+            uint32 Size = SerializedValue.Num();
+            Writer.SerializeIntPacked(PackedIndex);
+            Writer.SerializeIntPacked(Size);
+            Writer.Serialize(SerializedValue.GetData(), Size);
+        }
+        uint32 Terminator = 0;
+        Writer.SerializeIntPacked(Terminator);
+        return !Writer.IsError();
+    }
+
+    /**
+     * Applies a payload written by SerializeObjectDeltaToDefaults to TargetObject.
+     * With bResetToDefaults all other properties are reset to the class defaults first (in place reload).
+     */
+    static bool ApplyObjectDeltaToDefaults(const TArray<uint8>& BinaryData, UObject* TargetObject, bool bResetToDefaults)
+    {
+        if (BinaryData.Num() == 0 || !TargetObject)
+        {
+            return false;
+        }
+        const TArray<FProperty*>& PropertyTable = GetPropertyTable(TargetObject->GetClass());
+        if (bResetToDefaults)
+        {
+            const UObject* Defaults = TargetObject->GetClass()->GetDefaultObject();
+            for (const FProperty* Property : PropertyTable)
+            {
+                Property->CopyCompleteValue_InContainer(TargetObject, Defaults);
+            }
+        }
+
+        FMemoryReader Reader(BinaryData, true);
+        TArray<uint8> SerializedValue;
+        while (!Reader.AtEnd() && !Reader.IsError())
+        {
+            uint32 PackedIndex = 0;
+            Reader.SerializeIntPacked(PackedIndex);
+            if (PackedIndex == 0)
+            {
+                return true;
+            }
+            uint32 Size = 0;
+            Reader.SerializeIntPacked(Size);
+            if (!PropertyTable.IsValidIndex(PackedIndex - 1) || Size > static_cast<uint32>(Reader.TotalSize() - Reader.Tell()))
+            {
+                return false;
+            }
+            SerializedValue.SetNumUninitialized(Size);
+            Reader.Serialize(SerializedValue.GetData(), Size);
+            if (!ReadPropertyValue(PropertyTable[PackedIndex - 1], TargetObject, SerializedValue))
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    static UObject* DeserializeObjectDeltaToDefaults(const TArray<uint8>& BinaryData, UObject* Outer, UClass* CastToClass)
+    {
+        if (BinaryData.Num() > 0 && CastToClass)
+        {
+            // a new object starts with the values of the class default object
+            if (UObject* DeserializedObject = NewObject<UObject>(Outer, CastToClass);
+                DeserializedObject && ApplyObjectDeltaToDefaults(BinaryData, DeserializedObject, false))
+            {
+                return DeserializedObject;
+            }
+        }
+        return nullptr;
+    }
+
+    static FString SerializeObject(UObject* StorageObject)
+    {
+        TArray<uint8> BinaryData;
+        if (SerializeObjectToBytes(StorageObject, BinaryData))
+        {
             return FBase64::Encode(BinaryData);
         }
         return TEXT("");
@@ -225,23 +346,12 @@ public:
         if (!SerializedObj.IsEmpty())
         {
             TArray<uint8> BinaryData;
-
             if (FBase64::Decode(SerializedObj, BinaryData))
             {
-                FMemoryReader Reader(BinaryData, true);
-                FObjectAndNameAsStringProxyArchive Ar(Reader, true);
-                UObject* DeserializedObject = NULL;
-                if (CastToClass)
-                {
-                    if (DeserializedObject = NewObject<UObject>(Outer, CastToClass);
-                        DeserializedObject)
-                    {
-                        DeserializedObject->Serialize(Ar);
-                        return DeserializedObject;
-                    }
-                }
+                return DeserializeObjectFromBytes(BinaryData, Outer, CastToClass);
             }
         }
         return nullptr;
     }
+#pragma endregion
 };
@@ -0,0 +1,17 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+
+/**
+ * Enum for the aggregate calculated over a numeric property of all entries
+ */
+UENUM(BlueprintType)
+enum class EBA_EAggregateOp : uint8 {
+		E_Sum				UMETA(DisplayName = "Aggregate: Sum"),
+		E_Min				UMETA(DisplayName = "Aggregate: Min"),
+		E_Max				UMETA(DisplayName = "Aggregate: Max"),
+		E_Mean				UMETA(DisplayName = "Aggregate: Mean"),
+		E_Count				UMETA(DisplayName = "Aggregate: Count"),
+		E_CountAbove		UMETA(DisplayName = "Aggregate: Count Above Threshold"),
+		E_UNDEFINED			UMETA(DisplayName = "UNDEFINED", Hidden)
+	};
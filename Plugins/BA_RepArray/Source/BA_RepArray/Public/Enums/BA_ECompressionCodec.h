@@ -0,0 +1,15 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+
+/**
+ * Enum for the compression codec of a binary entry payload
+ */
+UENUM(BlueprintType)
+enum class EBA_ECompressionCodec : uint8 {
+		E_None				UMETA(DisplayName = "Compression: None"),
+		E_LZ4				UMETA(DisplayName = "Compression: LZ4"),
+		E_Zlib				UMETA(DisplayName = "Compression: Zlib"),
+		E_Oodle				UMETA(DisplayName = "Compression: Oodle"),
+		E_UNDEFINED			UMETA(DisplayName = "UNDEFINED", Hidden)
+	};
\ No newline at end of file
@@ -0,0 +1,14 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+
+/**
+ * Enum for the storage format of the serialized entry payload
+ */
+UENUM(BlueprintType)
+enum class EBA_EPayloadFormat : uint8 {
+		E_Base64String		UMETA(DisplayName = "Payload: Base64 String"),
+		E_Binary			UMETA(DisplayName = "Payload: Binary"),
+		E_DefaultsDelta		UMETA(DisplayName = "Payload: Binary Delta to Class Defaults"),
+		E_UNDEFINED			UMETA(DisplayName = "UNDEFINED", Hidden)
+	};
\ No newline at end of file
@@ -0,0 +1,20 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+
+/**
+ * Enum for the comparison of a query predicate
+ */
+UENUM(BlueprintType)
+enum class EBA_EQueryOperator : uint8 {
+		E_Equal				UMETA(DisplayName = "Query: Equal"),
+		E_NotEqual			UMETA(DisplayName = "Query: Not Equal"),
+		E_Less				UMETA(DisplayName = "Query: Less"),
+		E_LessEqual			UMETA(DisplayName = "Query: Less Or Equal"),
+		E_Greater			UMETA(DisplayName = "Query: Greater"),
+		E_GreaterEqual		UMETA(DisplayName = "Query: Greater Or Equal"),
+		E_Range				UMETA(DisplayName = "Query: In Range"),
+		E_Contains			UMETA(DisplayName = "Query: Contains"),
+		E_ClassIs			UMETA(DisplayName = "Query: Class Is"),
+		E_UNDEFINED			UMETA(DisplayName = "UNDEFINED", Hidden)
+	};
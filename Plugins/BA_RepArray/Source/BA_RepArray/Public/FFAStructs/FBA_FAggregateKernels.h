@@ -0,0 +1,23 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+* Aggregates over a numeric column, only rows set in Mask are included (Mask.Num() rows are read).
+* Double columns are processed four rows per step with VectorRegister4Double, int64 columns with a plain loop.
+*/
+struct BA_REPARRAY_API FBA_FAggregateKernels
+{
+	// sum of the masked values, OutCount is the number of masked rows (mean = sum / count)
+	static double Sum(const double* Values, const TBitArray<>& Mask, int32& OutCount);
+	static double Sum(const int64* Values, const TBitArray<>& Mask, int32& OutCount);
+
+	// false if no row is masked
+	static bool MinMax(const double* Values, const TBitArray<>& Mask, double& OutMin, double& OutMax);
+	static bool MinMax(const int64* Values, const TBitArray<>& Mask, double& OutMin, double& OutMax);
+
+	// number of masked values greater than Threshold
+	static int32 CountAbove(const double* Values, const TBitArray<>& Mask, double Threshold);
+	static int32 CountAbove(const int64* Values, const TBitArray<>& Mask, double Threshold);
+};
@@ -0,0 +1,84 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "FBA_FClassTable.generated.h"
+
+/**
+* Index replicated as variable length integer, small indices only need one byte
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FPackedIndex
+{
+	GENERATED_BODY()
+
+	FBA_FPackedIndex() = default;
+	FBA_FPackedIndex(int32 InIndex) : Index(InIndex) { }
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+	int32 Get() const { return Index; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	FORCEINLINE bool operator==(const FBA_FPackedIndex& Other) const
+	{
+		return Index == Other.Index;
+	}
+
+private:
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+};
+
+template<>
+struct TStructOpsTypeTraits< FBA_FPackedIndex > : public TStructOpsTypeTraitsBase2< FBA_FPackedIndex >
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/**
+* Classes (object entries) and script structs (struct entries) of all entries of a FBA_FFA_ObjectArray.
+* Entries reference their type by index, the table only grows, so after the first replication only newly added types are sent.
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FClassTable
+{
+	GENERATED_BODY()
+
+public:
+
+	// returns the index of Type, adds it to the table if needed (server only)
+	int32 FindOrAdd(UStruct* Type);
+
+	// nullptr if the index is not valid, the type is no class or has not been received yet
+	UClass* GetClass(int32 ClassIndex) const
+	{
+		return Types.IsValidIndex(ClassIndex) ? Cast<UClass>(Types[ClassIndex].Get()) : nullptr;
+	}
+
+	// nullptr if the index is not valid, the type is no script struct or has not been received yet
+	UScriptStruct* GetStruct(int32 ClassIndex) const
+	{
+		return Types.IsValidIndex(ClassIndex) ? Cast<UScriptStruct>(Types[ClassIndex].Get()) : nullptr;
+	}
+
+	const TArray<TObjectPtr<UStruct>>& GetTypes() const { return Types; }
+
+	int32 Num() const { return Types.Num(); }
+
+	void Clear();
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UStruct>> Types;
+
+	// server side lookup, the table is too small to bother clients with it
+	UPROPERTY(NotReplicated, Transient)
+	TMap<TObjectPtr<UStruct>, int32> TypeToIndex;
+};
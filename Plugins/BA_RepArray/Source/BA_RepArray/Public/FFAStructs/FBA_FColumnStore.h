@@ -0,0 +1,100 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+#include "UObject/ObjectKey.h"
+
+/**
+* One numeric property of all entries, rows are the slots of the entry handles (stable while entries move).
+* Integer properties are stored as int64, floating point properties as double. A property seen with both kinds
+* in different classes is stored as double.
+*/
+struct BA_REPARRAY_API FBA_FNumericColumn
+{
+public:
+
+	bool IsInteger() const { return bInteger; }
+
+	// false for rows of classes without the property
+	bool IsSet(int32 Row) const { return Present.IsValidIndex(Row) && Present[Row]; }
+
+	double GetDouble(int32 Row) const
+	{
+		return bInteger ? static_cast<double>(Integers[Row]) : Doubles[Row];
+	}
+
+	int64 GetInteger(int32 Row) const
+	{
+		return bInteger ? Integers[Row] : static_cast<int64>(Doubles[Row]);
+	}
+
+	// contiguous values, only valid for rows with IsSet
+	const TArray<double>& GetDoubles() const { return Doubles; }
+	const TArray<int64>& GetIntegers() const { return Integers; }
+	const TBitArray<>& GetPresent() const { return Present; }
+
+	int32 NumSet() const { return SetCount; }
+
+private:
+
+	friend struct FBA_FColumnStore;
+
+	void SetNum(int32 NumRows);
+	void SetInteger(int32 Row, int64 Value);
+	void SetDouble(int32 Row, double Value);
+	void ClearRow(int32 Row);
+	void ConvertToDouble();
+
+	bool bInteger = true;
+
+	TArray<double> Doubles;
+
+	TArray<int64> Integers;
+
+	// null bitmap
+	TBitArray<> Present;
+
+	int32 SetCount = 0;
+};
+
+/**
+* Structure of arrays copy of the numeric properties of all entries of a FBA_FFA_ObjectArray, one column per property name.
+* Written when an entry is added or changed, so sorting, filtering and aggregation can scan the columns without deserializing.
+*/
+struct BA_REPARRAY_API FBA_FColumnStore
+{
+public:
+
+	// writes all numeric properties of Container (of type EntryType) to Row, columns of other properties are cleared for Row
+	void SetRow(int32 Row, const UStruct* EntryType, const void* Container);
+
+	void ClearRow(int32 Row);
+
+	void Clear();
+
+	// drops the numeric property lists of all types, needed once types were reloaded
+	void ResetTypeCache() { NumericProperties.Reset(); }
+
+	// nullptr if no entry had a numeric property PropertyName so far
+	const FBA_FNumericColumn* FindColumn(FName PropertyName) const { return Columns.Find(PropertyName); }
+
+	const TMap<FName, FBA_FNumericColumn>& GetColumns() const { return Columns; }
+
+	int32 NumRows() const { return RowCount; }
+
+private:
+
+	// numeric properties of a type, looked up once per type
+	const TArray<const FNumericProperty*>& GetNumericProperties(const UStruct* EntryType);
+
+	TMap<FName, FBA_FNumericColumn> Columns;
+
+	// keyed by TObjectKey, so a new type at the address of a collected one does not reuse its properties
+	TMap<TObjectKey<UStruct>, TArray<const FNumericProperty*>> NumericProperties;
+
+	// columns written for every row, needed to clear the row without touching all columns
+	TArray<TArray<FName>> RowColumns;
+
+	int32 RowCount = 0;
+};
@@ -5,6 +5,11 @@
 #include "UObject/Object.h"
 #include "CoreMinimal.h"
 #include "Enums/BA_EEntrySource.h"
+#include "Enums/BA_EPayloadFormat.h"
+#include "FFAStructs/FBA_FPayload.h"
+#include "FFAStructs/FBA_FPropertyPatch.h"
+#include "FFAStructs/FBA_FClassTable.h"
+#include "FFAStructs/FBA_FIdentifier.h"
 #include "FBA_FFA_Object.generated.h"
 
 USTRUCT(BlueprintType, Blueprintable)
@@ -12,9 +17,10 @@ struct BA_REPARRAY_API FBA_FFA_Object : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
-    FBA_FFA_Object() : SourceObject(EBA_EEntrySource::E_Object), SerializedObject(""), ClassToCastTo(UObject::StaticClass()), SortIndex(INDEX_NONE), InstanceGuid(FGuid()), InstanceIdentifier("") { }
+    FBA_FFA_Object() : SourceObject(EBA_EEntrySource::E_Object), PayloadFormat(EBA_EPayloadFormat::E_Base64String), SerializedObject(""), ClassToCastTo(UObject::StaticClass()), SortIndex(INDEX_NONE), InstanceGuid(FGuid()) { }
     FBA_FFA_Object(FString SerializedStorageObject, UClass* StorageObjectClass);
     FBA_FFA_Object(FGuid Guid, FString SerializedStorageObject, UClass* StorageObjectClass);
+    FBA_FFA_Object(FGuid Guid, FBA_FPayload&& StorageObjectPayload, UClass* StorageObjectClass);
 
 	friend struct FBA_FFA_ObjectArray;
     friend class ABA_ReplicationInfo;
@@ -23,6 +29,9 @@ public:
 
     void GetIdentifier(FString& HumanReadableName);
 
+    // builds the readable identifier from its compact form
+    FString GetReadableIdentifier() const { return InstanceIdentifier.ToString(InstanceGuid); }
+
     void GetInstanceGuid(FGuid EntryGuid);
 
     void GetSortingIndex(int32 SortIndexInArray);
@@ -31,6 +40,20 @@ public:
 
     FString ToString();
 
+    EBA_EPayloadFormat GetPayloadFormat() const { return PayloadFormat; }
+
+    int32 GetPatchRevision() const { return PropertyPatch.GetRevision(); }
+
+    bool HasPayload() const;
+
+    bool IsStructEntry() const { return SourceObject == EBA_EEntrySource::E_Struct; }
+
+    // index of the entry class in the class table of the array, INDEX_NONE if not stored in a table
+    int32 GetClassIndex() const { return ClassIndex.Get(); }
+
+    // Converts the stored payload into NewFormat without deserializing the stored object
+    bool ConvertPayloadFormat(EBA_EPayloadFormat NewFormat);
+
 #pragma region Compare and Sort
 
 #pragma region Compare by InstanceGuid
@@ -83,21 +106,48 @@ private:
     UPROPERTY()
     EBA_EEntrySource SourceObject;
 
+    UPROPERTY()
+    EBA_EPayloadFormat PayloadFormat;
+
+    // used with EBA_EPayloadFormat::E_Base64String
     UPROPERTY()
     FString SerializedObject;
 
+    // used with EBA_EPayloadFormat::E_Binary and E_DefaultsDelta
+    UPROPERTY()
+    FBA_FPayload Payload;
+
+    // id of a payload in the FBA_FFA_PayloadStore, used instead of Payload if set
+    UPROPERTY()
+    int32 SharedPayloadId = 0;
+
+    // index into the class table of the owning array, replicated instead of ClassToCastTo
+    UPROPERTY()
+    FBA_FPackedIndex ClassIndex;
+
+    // properties changed since the payload was written
+    UPROPERTY()
+    FBA_FPropertyPatch PropertyPatch;
+
 public:
 
-    UPROPERTY(BlueprintReadOnly)
+    // resolved from the class table on clients
+    UPROPERTY(BlueprintReadOnly, NotReplicated)
     UClass* ClassToCastTo;
 
     UPROPERTY(BlueprintReadOnly)
 	int32 SortIndex;
 
+    // incremented whenever the full payload is replaced
+    UPROPERTY(BlueprintReadOnly)
+    int32 PayloadRevision = 0;
+
 	UPROPERTY(BlueprintReadOnly)
 	FGuid InstanceGuid = FGuid::NewGuid();
 
-    UPROPERTY(BlueprintReadOnly)
-    FString InstanceIdentifier = InstanceGuid.ToString();
+    // compact identifier, guid based unless a dictionary or custom name is set, see GetReadableIdentifier
+    // (Blueprints: ABA_ReplicationInfo::GetReadableIdentifier, the former FString InstanceIdentifier member is gone)
+    UPROPERTY()
+    FBA_FIdentifier InstanceIdentifier;
 
 };
\ No newline at end of file
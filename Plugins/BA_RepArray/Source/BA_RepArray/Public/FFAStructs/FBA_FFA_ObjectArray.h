@@ -3,8 +3,19 @@
 #pragma once
 #include "Net/Serialization/FastArraySerializer.h"
 #include "UObject/Object.h"
+#include "UObject/StructOnScope.h"
 #include "CoreMinimal.h"
 #include "FFAStructs/FBA_FFA_Object.h"
+#include "FFAStructs/FBA_FFA_PayloadStore.h"
+#include "FFAStructs/FBA_FClassTable.h"
+#include "FFAStructs/FBA_FSlotMap.h"
+#include "FFAStructs/FBA_FSortKey.h"
+#include "FFAStructs/FBA_FSortedView.h"
+#include "FFAStructs/FBA_FPropertyIndex.h"
+#include "FFAStructs/FBA_FRangeIndex.h"
+#include "FFAStructs/FBA_FQuery.h"
+#include "FFAStructs/FBA_FColumnStore.h"
+#include "Enums/BA_EAggregateOp.h"
 #include "FBA_FFA_ObjectArray.generated.h"
 
 DECLARE_DELEGATE_OneParam(FEntryChange, FBA_FFA_Object /* Entry */)
@@ -42,31 +53,227 @@ public:
 #pragma endregion  
 #pragma endregion
 
-	bool AddEntry(UObject* StorageObject, FGuid InstanceGuid, FString ReadableIdentifier);
+	bool AddEntry(UObject* StorageObject, FGuid InstanceGuid, const FBA_FIdentifier& Identifier);
+	// serializes StorageObject once into Prototype, which can then be added multiple times with AddPreparedEntry
+	bool PrepareEntry(UObject* StorageObject, FBA_FFA_Object& Prototype);
+	// same as PrepareEntry for a struct instance, see EBA_EEntrySource::E_Struct
+	bool PrepareStructEntry(const UScriptStruct* StructType, const void* StructData, FBA_FFA_Object& Prototype);
+	bool AddPreparedEntry(const FBA_FFA_Object& Prototype, FGuid InstanceGuid, const FBA_FIdentifier& Identifier);
+	/**
+	* Adds all objects with one pass over the array, compression runs in parallel.
+	* @param Identifiers Optional identifiers, aligned with StorageObjects
+	* @param OutInstanceGuids Guids of the new entries aligned with StorageObjects, invalid if an object could not be added
+	* @return Number of entries added
+	*/
+	int32 AddEntries(const TArray<UObject*>& StorageObjects, const TArray<FBA_FIdentifier>& Identifiers, TArray<FGuid>& OutInstanceGuids);
+	// call once the prototype is not needed anymore
+	void ReleasePreparedEntry(FBA_FFA_Object& Prototype);
+	bool UpdateEntryProperties(FGuid InstanceGuid, UObject* ModifiedObject, TArray<FName>& ChangedProperties);
+	/**
+	* Sets a single property of an entry in place, the entry is marked dirty once.
+	* @param ValueProperty Type of Value, must match the entry property
+	* @param OutProperty The property of the entry class or struct that was set
+	*/
+	bool SetEntryProperty(FGuid InstanceGuid, FName PropertyName, const FProperty* ValueProperty, const void* Value, const FProperty*& OutProperty);
+	UObject* DeserializeEntry(const FBA_FFA_Object& Entry, UObject* Outer) const;
+	// copies a struct entry into initialized memory of StructType, no object is created
+	bool CopyStructEntry(const FBA_FFA_Object& Entry, const UScriptStruct* StructType, void* OutStructData) const;
+	TSharedPtr<FStructOnScope> DeserializeStructEntry(const FBA_FFA_Object& Entry) const;
+	bool ApplyPropertyPatch(const FBA_FFA_Object& Entry, UObject* TargetObject, int32 SinceRevision) const;
+	bool RefreshObject(const FBA_FFA_Object& Entry, UObject* TargetObject, int32 KnownPayloadRevision, int32 KnownPatchRevision) const;
+	int32 MigratePayloadFormat(EBA_EPayloadFormat NewFormat);
 	bool CheckForSubobjectListSupport(FBA_FFA_Object& Entry);
 	void ForEachChildren(const TFunctionRef<void(FBA_FFA_Object)>& Func);
 	bool RemoveEntry(FGuid InstanceGuid, UObject*& DeletedEntry);
+	/**
+	* Removes all entries in one pass, holes are filled with entries from the end of the array.
+	* Removed entries are not deserialized.
+	* @param OutRemovedGuids Guids that were found and removed
+	* @return Number of entries removed
+	*/
+	int32 RemoveEntries(const TArray<FGuid>& InstanceGuids, TArray<FGuid>& OutRemovedGuids);
 	bool GetEntryByGuid(FGuid Guid, FBA_FFA_Object& ResultEntry);
+	// accepts every readable identifier: guid, dictionary words or custom name
 	bool GetEntryByIdentifier(FString Identifier, FBA_FFA_Object& ResultEntry);
+	bool GetEntryByIdentifier(const FBA_FIdentifier& Identifier, FBA_FFA_Object& ResultEntry);
+	// stable handle of an entry, unset if the guid is not found
+	FBA_FEntryHandle GetEntryHandle(const FGuid& Guid) const;
+	// O(1) lookup, nullptr if the entry of the handle was removed
+	const FBA_FFA_Object* FindEntry(const FBA_FEntryHandle& Handle) const;
+	bool GetEntryByHandle(const FBA_FEntryHandle& Handle, FBA_FFA_Object& ResultEntry) const;
 	void Clear();
 	void SortByIndex();
 	void SortByPropertyName(const FString PropertyName, TArray<FString> SortableTypesArray);
+	/**
+	* Creates or replaces a local sorted view, Items keeps its order and nothing is replicated.
+	* @param PropertyName Property to sort by, None sorts by the index the entries were added with
+	*/
+	bool CreateSortedView(FName ViewName, FName PropertyName, bool bDescending, const TArray<FString>& SortableTypes);
+	bool RemoveSortedView(FName ViewName);
+	const FBA_FSortedView* FindSortedView(FName ViewName) const;
+	/**
+	* Creates a local index from the values of PropertyName to the entries, kept up to date on add, remove and change.
+	* Enum values are indexed by their name, all other values like FBA_FSortKey::FromProperty.
+	*/
+	bool CreatePropertyIndex(FName PropertyName);
+	bool RemovePropertyIndex(FName PropertyName);
+	const FBA_FPropertyIndex* FindPropertyIndex(FName PropertyName) const;
+	// creates a local ordered index over a numeric property for range and rank queries, kept up to date like the property indexes
+	bool CreateRangeIndex(FName PropertyName);
+	bool RemoveRangeIndex(FName PropertyName);
+	const FBA_FRangeIndex* FindRangeIndex(FName PropertyName) const;
+	/**
+	* Creates or replaces a local filtered view, every entry is E_Filtered_Visible or E_Filtered_InVisible.
+	* The query is compiled once per class, statuses are updated per entry on add, remove and change.
+	*/
+	bool CreateFilteredView(FName ViewName, const FBA_FQuery& Query);
+	bool RemoveFilteredView(FName ViewName);
+	const FBA_FFilteredView* FindFilteredView(FName ViewName) const;
+	// drops everything compiled per entry type (property pointers and offsets), call after types were reloaded
+	void ResetTypeCaches();
+	// client side, indexes and announces the entries that were waiting for the shared payload PayloadId
+	void ResolveSharedPayload(int32 PayloadId);
+	/**
+	* Handles of a window of the array order (ViewName None), a sorted view or the visible entries of a filtered view.
+	* @param After Starts after this entry if it is still part of the view, otherwise at Offset
+	* @param OutTotal Number of entries in the view
+	* @return false if ViewName is neither a sorted nor a filtered view
+	*/
+	// keeps a column of every numeric property, rows are the slots of the entry handles (builds the columns when enabled)
+	void SetNumericColumns(bool bEnabled);
+	bool HasNumericColumns() const { return bNumericColumns; }
+	// nullptr if the columns are disabled or no entry has a numeric property PropertyName
+	const FBA_FNumericColumn* GetNumericColumn(FName PropertyName) const;
+	/**
+	* Aggregates a numeric property over all entries, scans the numeric column if enabled and reads the entries otherwise.
+	* @param FilterViewName Filtered view whose visible entries are aggregated, None for all entries
+	* @param Threshold Used by E_CountAbove
+	* @param OutCount Number of values aggregated
+	* @return false if FilterViewName does not exist
+	*/
+	bool Aggregate(FName PropertyName, EBA_EAggregateOp Op, FName FilterViewName, double Threshold, double& OutResult, int32& OutCount) const;
+	/**
+	* Handles of one page of the array (ViewName None), a sorted view or a filtered view.
+	* @param After Continue behind this entry instead of at Offset, if it is still part of the view
+	* @param bSlotOrder Page the array and filtered views in handle slot order instead of array order. Removals never move
+	* other entries across a position in slot order, so continuing After a removed entry neither skips nor repeats entries.
+	*/
+	bool GetViewPage(FName ViewName, int32 Offset, int32 Count, const FBA_FEntryHandle& After, bool bSlotOrder, TArray<FBA_FEntryHandle>& OutHandles, int32& OutTotal) const;
+	void SetPropertyDeltaReplication(bool bEnabled);
+	// class of an entry, resolved through the class table
+	UClass* GetEntryClass(const FBA_FFA_Object& Entry) const;
+	// script struct of a struct entry, nullptr for object entries
+	UScriptStruct* GetEntryStruct(const FBA_FFA_Object& Entry) const;
 private:
 
+	bool WriteEntryPayload(UObject* StorageObject, FBA_FFA_Object& Entry);
+	bool WriteStructPayload(const UScriptStruct* StructType, const void* StructData, FBA_FFA_Object& Entry);
+	// rewrites the payload from CurrentObject once the property patch got too large
+	void RebaseIfNeeded(UObject* CurrentObject, FBA_FFA_Object& Entry);
+	static bool SerializeObjectPayload(UObject* StorageObject, EBA_EPayloadFormat Format, TArray<uint8>& OutBytes);
+	// replaces the payload of Entry with BinaryData, the old payload is kept if the new one cannot be stored
+	bool ReplaceEntryPayload(TArray<uint8>&& BinaryData, EBA_EPayloadFormat Format, FBA_FFA_Object& Entry);
+	// turns serialized bytes into the payload of Entry (Base64 or binary + compression), thread safe
+	// false (and no payload) if the result exceeds the limits receivers accept, see FBA_FPayload::FitsNetLimits
+	bool EncodePayload(TArray<uint8>&& BinaryData, FBA_FFA_Object& Entry) const;
+	// moves the payload of Entry into the shared payload store if enabled
+	void SharePayload(FBA_FFA_Object& Entry);
+	void ReleaseSharedPayload(FBA_FFA_Object& Entry);
+	// position of an entry in Items, INDEX_NONE if not found
+	int32 FindPosition(const FGuid& Guid) const;
+	// issues a handle for the entry at Position and adds it to the guid and identifier index
+	FBA_FEntryHandle IndexEntry(int32 Position);
+	// removes the entry from the guid and identifier index, the slot is released separately
+	void UnindexEntry(const FBA_FFA_Object& Entry);
+	// relinks the handles after Items was reordered
+	void RelinkEntries();
+	// issues new handles for all entries
+	void RebuildEntryIndex();
+	// sort key of PropertyName for every entry, aligned with Items (unset for other classes or types not in SortableTypes)
+	void BuildSortKeyColumn(FName PropertyName, const TArray<FString>& SortableTypes, TArray<FBA_FSortKey>& OutSortKeys) const;
+	// class of object entries, script struct of struct entries
+	const UStruct* GetEntryType(const FBA_FFA_Object& Entry) const;
+	// nullptr if EntryType has no property PropertyName of a sortable type
+	static const FProperty* FindSortProperty(const UStruct* EntryType, FName PropertyName, const TArray<FString>& SortableTypes);
+	FBA_FSortKey ReadSortKey(const FBA_FFA_Object& Entry, const FProperty* Property) const;
+	void BuildSortedView(FBA_FSortedView& View) const;
+	void BuildPropertyIndex(FBA_FPropertyIndex& Index) const;
+	void BuildRangeIndex(FBA_FRangeIndex& Index) const;
+	void BuildFilteredView(FBA_FFilteredView& View) const;
+	// calls Func with the deserialized container of every entry whose type has a property returned by FindProperty
+	void ForEachPropertyValue(const TFunctionRef<const FProperty*(const UStruct*)>& FindProperty
+		, const TFunctionRef<void(int32 /* Position */, const FProperty*, const void* /* Container */)>& Func) const;
+	// nullptr if EntryType has no numeric property PropertyName
+	static const FProperty* FindRangeProperty(const UStruct* EntryType, FName PropertyName);
+	static bool ReadRangeValue(const FProperty* Property, const void* Container, double& OutValue);
+	// inserts or moves the entry at Position in all views and indexes
+	void UpdateSecondaryIndexes(int32 Position);
+	void RemoveFromSecondaryIndexes(const FBA_FEntryHandle& Handle);
+	const FBA_FPayload* GetBinaryPayload(const FBA_FFA_Object& Entry) const;
+	// true if Entry references a shared payload that has not been received yet
+	bool IsSharedPayloadPending(const FBA_FFA_Object& Entry) const;
+	// client side, defers the add or change callback of Entry until its shared payload is received
+	void DeferUntilSharedPayload(const FBA_FFA_Object& Entry, bool bAdded);
+	int32 GetEntryPayloadSize(const FBA_FFA_Object& Entry) const;
+	const TArray<uint8>* GetEntryPayloadBytes(const FBA_FFA_Object& Entry, TArray<uint8>& Buffer) const;
+
 	UPROPERTY()
 	TArray<FBA_FFA_Object> Items;
 
-	UPROPERTY(NotReplicated)
-	TMap<FGuid, int32> GuidToArrayPos;
+	// primary index, maps stable handles to positions in Items (not replicated, rebuilt on clients from the callbacks)
+	FBA_FSlotMap EntrySlots;
 
 	UPROPERTY(NotReplicated)
-	TMap<FString, int32> IdentifierToArrayPos;
+	TMap<FGuid, FBA_FEntryHandle> GuidToHandle;
+
+	// keyed by the compact identifier, guid based identifiers are not stored
+	TMap<FBA_FIdentifier, FBA_FEntryHandle> IdentifierToHandle;
+
+	// client side positions from PreReplicatedRemove, released in PostReplicatedReceive
+	TArray<int32> PendingRemovals;
+
+	struct FPendingSharedPayloadEntry
+	{
+		FBA_FEntryHandle Handle;
+		// the add callback is still due, otherwise the change callback
+		bool bAdded = false;
+	};
+
+	// client side entries by the shared payload id they are waiting for, see ResolveSharedPayload
+	TMultiMap<int32, FPendingSharedPayloadEntry> PendingSharedPayloadEntries;
+
+	// local sort orders by view name, see CreateSortedView
+	TMap<FName, FBA_FSortedView> SortedViews;
+
+	// local value indexes by property name, see CreatePropertyIndex
+	TMap<FName, FBA_FPropertyIndex> PropertyIndexes;
+
+	// local ordered indexes by numeric property name, see CreateRangeIndex
+	TMap<FName, FBA_FRangeIndex> RangeIndexes;
+
+	// local query results by view name, see CreateFilteredView
+	TMap<FName, FBA_FFilteredView> FilteredViews;
+
+	// structure of arrays copy of the numeric properties, see SetNumericColumns
+	FBA_FColumnStore NumericColumns;
+
+	bool bNumericColumns = false;
 
 	UPROPERTY(NotReplicated, Transient)
 	TObjectPtr<AActor> Owner;
 
 	UPROPERTY(NotReplicated, Transient)
 	TMap<FString, FString> EntryObjectsPropertyMap;
+
+	// payload settings used for newly added entries, set by the owning ABA_ReplicationInfo
+	UPROPERTY(NotReplicated, Transient)
+	FBA_FPayloadSettings PayloadSettings;
+
+	// store of shared payloads, replicated separately by the owning ABA_ReplicationInfo
+	FBA_FFA_PayloadStore* SharedPayloadStore = nullptr;
+
+	// classes referenced by the entries, replicated separately by the owning ABA_ReplicationInfo
+	FBA_FClassTable* ClassTable = nullptr;
 	
 	FEntryChange OnEntryPreReplicatedRemove;
 	FEntryChange OnEntryPostReplicatedAdd;
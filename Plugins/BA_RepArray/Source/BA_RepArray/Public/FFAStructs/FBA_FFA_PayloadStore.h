@@ -0,0 +1,109 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "Net/Serialization/FastArraySerializer.h"
+#include "UObject/Object.h"
+#include "CoreMinimal.h"
+#include "FFAStructs/FBA_FPayload.h"
+#include "FBA_FFA_PayloadStore.generated.h"
+
+DECLARE_DELEGATE_OneParam(FSharedPayloadReceived, int32 /* PayloadId */)
+
+/**
+* One unique payload shared by all entries referencing its PayloadId
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FFA_SharedPayload : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	friend struct FBA_FFA_PayloadStore;
+
+public:
+
+	int32 GetPayloadId() const { return PayloadId; }
+	const FBA_FPayload& GetPayload() const { return Payload; }
+
+private:
+	UPROPERTY()
+	int32 PayloadId = 0;
+
+	UPROPERTY()
+	FBA_FPayload Payload;
+
+	// content hash of the payload, server only
+	UPROPERTY(NotReplicated)
+	uint64 ContentHash = 0;
+
+	// number of entries referencing this payload, server only
+	UPROPERTY(NotReplicated)
+	int32 ReferenceCount = 0;
+};
+
+/**
+* Content addressed store of payloads shared between entries of a FBA_FFA_ObjectArray.
+* Identical payloads are stored and replicated once, entries reference them by PayloadId.
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FFA_PayloadStore : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+public:
+
+	static constexpr int32 InvalidPayloadId = 0;
+
+	/**
+	* Adds a reference to the payload with identical content, or stores the payload if it is new.
+	* @return Id of the shared payload, InvalidPayloadId if the payload is empty
+	*/
+	int32 Acquire(FBA_FPayload&& Payload);
+
+	void AddReference(int32 PayloadId);
+
+	// removes a reference, the payload is removed once it is not referenced anymore
+	void Release(int32 PayloadId);
+
+	const FBA_FPayload* Find(int32 PayloadId) const;
+
+	int32 Num() const { return Items.Num(); }
+
+	void Clear();
+
+	// client side, called for every new payload once the received update is applied
+	FSharedPayloadReceived OnPayloadReceived;
+
+#pragma region FFastArraySerializer
+	void PreReplicatedRemove(const TArrayView<int32>& RemovedIndices, int32 FinalSize);
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+#pragma endregion
+
+private:
+
+	void RebuildIndexMap();
+
+	UPROPERTY()
+	TArray<FBA_FFA_SharedPayload> Items;
+
+	TMap<int32, int32> PayloadIdToArrayPos;
+
+	TMultiMap<uint64, int32> ContentHashToPayloadId;
+
+	// client side ids from PostReplicatedAdd, announced in PostReplicatedReceive
+	TArray<int32> ReceivedPayloadIds;
+
+	int32 NextPayloadId = 1;
+
+	bool bIndexMapDirty = false;
+};
+
+template<>
+struct TStructOpsTypeTraits< FBA_FFA_PayloadStore > : public TStructOpsTypeTraitsBase2< FBA_FFA_PayloadStore >
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
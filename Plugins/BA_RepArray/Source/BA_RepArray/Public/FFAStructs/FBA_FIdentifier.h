@@ -0,0 +1,119 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "FBA_FIdentifier.generated.h"
+
+/**
+* Word lists used for readable identifiers (Resources/DataFiles), loaded once and shared by all arrays
+*/
+class BA_REPARRAY_API FBA_FIdentifierDictionary
+{
+public:
+
+	static const FBA_FIdentifierDictionary& Get();
+
+	bool IsValid() const { return Adjectives.Num() > 0 && Names.Num() > 0; }
+	int32 NumAdjectives() const { return Adjectives.Num(); }
+	int32 NumNames() const { return Names.Num(); }
+
+	// concatenates two adjectives and one name, empty if an index is not valid
+	FString BuildString(uint16 FirstAdjective, uint16 SecondAdjective, uint16 Name) const;
+
+	// splits a string built by BuildString back into its word indices
+	bool ParseString(const FString& Identifier, uint16& OutFirstAdjective, uint16& OutSecondAdjective, uint16& OutName) const;
+
+private:
+
+	FBA_FIdentifierDictionary();
+
+	static bool LoadFileToArray(const FString& FileName, TArray<FString>& TargetArray);
+
+	TArray<FString> Adjectives;
+	TArray<FString> Names;
+
+	TMap<FString, uint16> AdjectiveToIndex;
+	TMap<FString, uint16> NameToIndex;
+};
+
+/**
+* Compact identifier of an entry: either derived from the InstanceGuid (nothing stored), three word indices
+* into the FBA_FIdentifierDictionary or a custom FName. The readable string is only built on request.
+*/
+USTRUCT(BlueprintType)
+struct BA_REPARRAY_API FBA_FIdentifier
+{
+	GENERATED_BODY()
+
+	enum class EKind : uint8
+	{
+		Guid,
+		Dictionary,
+		Name,
+	};
+
+	FBA_FIdentifier() = default;
+
+	static FBA_FIdentifier FromDictionary(uint16 FirstAdjective, uint16 SecondAdjective, uint16 Name);
+	static FBA_FIdentifier FromName(FName Name);
+
+	// dictionary identifier if Identifier was built from the dictionary, otherwise a custom name (empty stays guid based)
+	static FBA_FIdentifier FromString(const FString& Identifier);
+
+	// like FromString, but never creates a new FName - returns false if the identifier cannot exist
+	static bool FindFromString(const FString& Identifier, FBA_FIdentifier& OutIdentifier);
+
+	EKind GetKind() const { return Kind; }
+	bool IsGuidBased() const { return Kind == EKind::Guid; }
+
+	// builds the readable identifier, InstanceGuid is used for guid based identifiers
+	FString ToString(const FGuid& InstanceGuid) const;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	FORCEINLINE bool operator==(const FBA_FIdentifier& Other) const
+	{
+		return Kind == Other.Kind
+			&& (Kind != EKind::Dictionary || (Words[0] == Other.Words[0] && Words[1] == Other.Words[1] && Words[2] == Other.Words[2]))
+			&& (Kind != EKind::Name || CustomName == Other.CustomName);
+	}
+
+	FORCEINLINE bool operator!=(const FBA_FIdentifier& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FBA_FIdentifier& Identifier)
+	{
+		switch (Identifier.Kind)
+		{
+		case EKind::Dictionary:
+			return HashCombine(HashCombine(GetTypeHash(Identifier.Words[0]), GetTypeHash(Identifier.Words[1])), GetTypeHash(Identifier.Words[2]));
+		case EKind::Name:
+			return GetTypeHash(Identifier.CustomName);
+		default:
+			return 0;
+		}
+	}
+
+private:
+
+	EKind Kind = EKind::Guid;
+
+	// adjective, adjective, name
+	uint16 Words[3] = { 0, 0, 0 };
+
+	FName CustomName;
+};
+
+template<>
+struct TStructOpsTypeTraits< FBA_FIdentifier > : public TStructOpsTypeTraitsBase2< FBA_FIdentifier >
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true,
+	};
+};
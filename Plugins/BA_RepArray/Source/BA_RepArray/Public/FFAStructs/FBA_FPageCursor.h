@@ -0,0 +1,42 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "FFAStructs/FBA_FSlotMap.h"
+#include "FBA_FPageCursor.generated.h"
+
+/**
+* Position in the array, a sorted view or a filtered view for reading it page by page.
+* The cursor continues after the last entry it returned, so removed entries do not shift the next page.
+* The array and filtered views are paged in handle slot order, which removals never reorder.
+* Sorted views are paged in view order, if the last returned entry was removed the cursor continues at Offset.
+*/
+USTRUCT(BlueprintType)
+struct BA_REPARRAY_API FBA_FPageCursor
+{
+	GENERATED_BODY()
+
+	FBA_FPageCursor() = default;
+	FBA_FPageCursor(FName InViewName, int32 InPageSize, int32 InOffset)
+		: ViewName(InViewName), PageSize(InPageSize), Offset(InOffset) { }
+
+	// sorted or filtered view, None iterates all entries
+	UPROPERTY(BlueprintReadOnly, Category = "BA Rep Array|Paging")
+	FName ViewName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "BA Rep Array|Paging")
+	int32 PageSize = 0;
+
+	// offset of the next page, used for the first page and if the last returned entry of a sorted view does not exist anymore
+	UPROPERTY(BlueprintReadOnly, Category = "BA Rep Array|Paging")
+	int32 Offset = 0;
+
+	// true once the last page was returned
+	UPROPERTY(BlueprintReadOnly, Category = "BA Rep Array|Paging")
+	bool bEnd = false;
+
+	// last returned entry
+	UPROPERTY()
+	FBA_FEntryHandle Last;
+};
@@ -0,0 +1,129 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Enums/BA_EPayloadFormat.h"
+#include "Enums/BA_ECompressionCodec.h"
+#include "FBA_FPayload.generated.h"
+
+/**
+* Settings used by FBA_FFA_ObjectArray when creating new payloads, set by the owning ABA_ReplicationInfo
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FPayloadSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EBA_EPayloadFormat Format = EBA_EPayloadFormat::E_Binary;
+
+	// codec for binary payloads, E_None disables compression
+	UPROPERTY()
+	EBA_ECompressionCodec CompressionCodec = EBA_ECompressionCodec::E_None;
+
+	// binary payloads smaller than this (in bytes) are never compressed
+	UPROPERTY()
+	int32 CompressionThreshold = 256;
+
+	// store identical binary payloads once in the FBA_FFA_PayloadStore and reference them by id
+	UPROPERTY()
+	bool bSharePayloads = false;
+
+	// replicate only changed properties of updated entries instead of the full payload
+	UPROPERTY()
+	bool bPropertyDeltaReplication = false;
+
+	// the property patch is folded back into the payload once it exceeds this fraction of the payload size
+	UPROPERTY()
+	float PatchRebaseRatio = 0.5f;
+};
+
+/**
+* Raw binary payload of a serialized entry. Replicates as packed size + raw bytes (no Base64 overhead)
+* Optionally compressed, then the codec and the uncompressed size are stored with the data
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FPayload
+{
+	GENERATED_BODY()
+
+	FBA_FPayload() = default;
+	FBA_FPayload(TArray<uint8>&& PayloadData) : Data(MoveTemp(PayloadData)) { }
+
+	friend struct FBA_FFA_ObjectArray;
+
+public:
+
+	// upper bound accepted when receiving a payload, protects clients against corrupted size fields
+	static constexpr uint32 MaxNetPayloadSize = 1024 * 1024;
+
+	// upper bound accepted for the uncompressed size of a compressed payload
+	static constexpr uint32 MaxUncompressedSize = 16 * 1024 * 1024;
+
+	bool IsEmpty() const { return Data.IsEmpty(); }
+	int32 Num() const { return Data.Num(); }
+	const TArray<uint8>& GetData() const { return Data; }
+
+	bool IsCompressed() const { return Codec != EBA_ECompressionCodec::E_None; }
+
+	// false if receivers would reject the payload, checked before a payload is stored on the server
+	bool FitsNetLimits() const
+	{
+		return static_cast<uint32>(Data.Num()) <= MaxNetPayloadSize
+			&& (!IsCompressed() || static_cast<uint32>(UncompressedSize) <= MaxUncompressedSize);
+	}
+	EBA_ECompressionCodec GetCodec() const { return Codec; }
+	int32 GetUncompressedSize() const { return IsCompressed() ? UncompressedSize : Data.Num(); }
+
+	void Reset();
+
+	/**
+	* Compresses the payload with NewCodec. Skipped if the payload is already compressed,
+	* smaller than MinSizeToCompress or if the compressed result would not be smaller.
+	* @return true if the payload is compressed afterwards
+	*/
+	bool Compress(EBA_ECompressionCodec NewCodec, int32 MinSizeToCompress);
+
+	/**
+	* Returns the uncompressed bytes: the payload data itself or, if compressed, DecompressionBuffer filled with the decompressed data.
+	* @return nullptr if decompression failed
+	*/
+	const TArray<uint8>* GetUncompressedData(TArray<uint8>& DecompressionBuffer) const;
+
+	static FName GetCompressionFormatName(EBA_ECompressionCodec CompressionCodec);
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	FORCEINLINE bool operator==(const FBA_FPayload& Other) const
+	{
+		return Codec == Other.Codec && UncompressedSize == Other.UncompressedSize && Data == Other.Data;
+	}
+
+	FORCEINLINE bool operator!=(const FBA_FPayload& Other) const
+	{
+		return !(*this == Other);
+	}
+
+private:
+	UPROPERTY()
+	TArray<uint8> Data;
+
+	UPROPERTY()
+	EBA_ECompressionCodec Codec = EBA_ECompressionCodec::E_None;
+
+	// only valid if Codec != E_None
+	UPROPERTY()
+	int32 UncompressedSize = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits< FBA_FPayload > : public TStructOpsTypeTraitsBase2< FBA_FPayload >
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,47 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "FFAStructs/FBA_FSlotMap.h"
+#include "FFAStructs/FBA_FSortKey.h"
+
+/**
+* Secondary index of a FBA_FFA_ObjectArray, maps the values of one property to the handles of the entries having them.
+* Values are extracted when an entry is added or changed, lookups never touch a payload. Nothing is replicated.
+*/
+struct BA_REPARRAY_API FBA_FPropertyIndex
+{
+public:
+
+	FBA_FPropertyIndex() = default;
+	explicit FBA_FPropertyIndex(FName InPropertyName) : PropertyName(InPropertyName) { }
+
+	FName GetPropertyName() const { return PropertyName; }
+
+	// replaces the content of the index
+	void Reset(TArray<TPair<FBA_FEntryHandle, FBA_FSortKey>>&& Entries);
+
+	// adds the entry or moves it to the bucket of its new key, entries without a key are not indexed
+	void Set(const FBA_FEntryHandle& Handle, FBA_FSortKey&& Key);
+
+	bool Remove(const FBA_FEntryHandle& Handle);
+
+	void Clear();
+
+	// nullptr if no entry has Key
+	const TSet<FBA_FEntryHandle>* Find(const FBA_FSortKey& Key) const { return Buckets.Find(Key); }
+
+	// number of distinct values
+	int32 NumKeys() const { return Buckets.Num(); }
+
+	int32 Num() const { return Keys.Num(); }
+
+private:
+
+	FName PropertyName;
+
+	TMap<FBA_FSortKey, TSet<FBA_FEntryHandle>> Buckets;
+
+	// current key of every indexed entry, needed to leave the old bucket
+	TMap<FBA_FEntryHandle, FBA_FSortKey> Keys;
+};
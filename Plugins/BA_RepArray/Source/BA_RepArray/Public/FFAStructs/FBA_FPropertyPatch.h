@@ -0,0 +1,84 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "FBA_FPropertyPatch.generated.h"
+
+/**
+* Serialized value of one reflected property, keyed by its per-class property index (see BA_Statics::GetPropertyTable)
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FPropertyValue
+{
+	GENERATED_BODY()
+
+	FBA_FPropertyValue() = default;
+	FBA_FPropertyValue(uint16 IndexOfProperty, int32 PatchRevision, TArray<uint8>&& SerializedValue)
+		: PropertyIndex(IndexOfProperty), Revision(PatchRevision), Value(MoveTemp(SerializedValue)) { }
+
+	// upper bound accepted when receiving a single property value
+	static constexpr uint32 MaxNetValueSize = 64 * 1024;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	FORCEINLINE bool operator==(const FBA_FPropertyValue& Other) const
+	{
+		return PropertyIndex == Other.PropertyIndex && Revision == Other.Revision && Value == Other.Value;
+	}
+
+	UPROPERTY()
+	uint16 PropertyIndex = 0;
+
+	// patch revision in which this value was last changed
+	UPROPERTY()
+	int32 Revision = 0;
+
+	UPROPERTY()
+	TArray<uint8> Value;
+};
+
+template<>
+struct TStructOpsTypeTraits< FBA_FPropertyValue > : public TStructOpsTypeTraitsBase2< FBA_FPropertyValue >
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/**
+* Cumulative property changes of an entry since its payload was last (re)serialized.
+* Replicated element-wise with delta struct serialization, so only changed property values are sent.
+*/
+USTRUCT()
+struct BA_REPARRAY_API FBA_FPropertyPatch
+{
+	GENERATED_BODY()
+
+public:
+
+	bool IsEmpty() const { return Values.IsEmpty(); }
+	int32 GetRevision() const { return Revision; }
+	const TArray<FBA_FPropertyValue>& GetValues() const { return Values; }
+
+	// adds or overwrites the value of a property, sets it to the current revision
+	void SetValue(uint16 PropertyIndex, TArray<uint8>&& SerializedValue);
+
+	// starts a new revision, call once before setting the values of one update
+	int32 BeginRevision() { return ++Revision; }
+
+	// sum of all stored value sizes in bytes
+	int32 GetByteSize() const;
+
+	void Reset();
+
+private:
+	UPROPERTY()
+	TArray<FBA_FPropertyValue> Values;
+
+	UPROPERTY()
+	int32 Revision = 0;
+};
@@ -0,0 +1,159 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
+#include "Enums/BA_EQueryOperator.h"
+#include "Enums/BA_EEntryStatus.h"
+#include "FFAStructs/FBA_FSlotMap.h"
+#include "FFAStructs/FBA_FSortKey.h"
+#include "FBA_FQuery.generated.h"
+
+/**
+* One condition on a property of an entry, e.g. Weight < 5 or Stats.Name contains "Sword"
+*/
+USTRUCT(BlueprintType)
+struct BA_REPARRAY_API FBA_FQueryPredicate
+{
+	GENERATED_BODY()
+
+	// property name, nested struct properties separated by dots (e.g. "Stats.Weight"), not used by E_ClassIs
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	FString PropertyPath;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	EBA_EQueryOperator Operator = EBA_EQueryOperator::E_Equal;
+
+	// compared value as text: numbers, true/false, strings, names or enum value names (lowest value for E_Range)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	FString Value;
+
+	// highest value for E_Range
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	FString MaxValue;
+
+	// E_ClassIs: object entries of this class or a child class, if not set Value is compared with the class or struct name
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	TSubclassOf<UObject> Class;
+};
+
+/**
+* Predicates that all need to match
+*/
+USTRUCT(BlueprintType)
+struct BA_REPARRAY_API FBA_FQueryClause
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	TArray<FBA_FQueryPredicate> AllOf;
+};
+
+/**
+* Query over the entries of a FBA_FFA_ObjectArray: an entry matches if any clause matches (OR of ANDs).
+* An empty query matches every entry.
+*/
+USTRUCT(BlueprintType)
+struct BA_REPARRAY_API FBA_FQuery
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BA Rep Array|Query")
+	TArray<FBA_FQueryClause> AnyOf;
+};
+
+/**
+* FBA_FQuery compiled for one class or struct: property paths are resolved and values parsed once,
+* evaluating an entry only walks the resolved properties of its container.
+*/
+struct BA_REPARRAY_API FBA_FQueryPlan
+{
+public:
+
+	static FBA_FQueryPlan Compile(const FBA_FQuery& Query, const UStruct* EntryType);
+
+	// GetContainer is only called if a predicate reads a property
+	bool Matches(const TFunctionRef<const void*()>& GetContainer) const;
+
+	// false if the result only depends on the type of the entry
+	bool ReadsProperties() const { return bReadsProperties; }
+
+private:
+
+	struct FPredicate
+	{
+		EBA_EQueryOperator Operator = EBA_EQueryOperator::E_UNDEFINED;
+		// struct properties leading to Property
+		TArray<const FProperty*> Path;
+		const FProperty* Property = nullptr;
+		// element of array and set properties, compared by E_Contains
+		const FProperty* ElementProperty = nullptr;
+		FBA_FSortKey Value;
+		FBA_FSortKey MaxValue;
+	};
+
+	// value key in the representation FBA_FSortKey::FromPropertyValue reads for Property
+	static FBA_FSortKey ParseValue(const FProperty* Property, const FString& Value);
+
+	static bool Evaluate(const FPredicate& Predicate, const void* Container);
+
+	// OR of ANDs, E_ClassIs and predicates on missing properties are resolved on compile and not stored
+	TArray<TArray<FPredicate>> Clauses;
+
+	bool bMatchesAll = false;
+
+	bool bReadsProperties = false;
+};
+
+/**
+* Entries of a FBA_FFA_ObjectArray filtered by a query, the status of every entry is updated on add, remove and change.
+* Nothing is replicated and Items keeps its order.
+*/
+struct BA_REPARRAY_API FBA_FFilteredView
+{
+public:
+
+	FBA_FFilteredView() = default;
+	explicit FBA_FFilteredView(const FBA_FQuery& InQuery) : Query(InQuery) { }
+
+	// plan for EntryType, compiled on first use
+	const FBA_FQueryPlan& GetPlan(const UStruct* EntryType);
+
+	void SetStatus(const FBA_FEntryHandle& Handle, bool bVisible);
+
+	bool Remove(const FBA_FEntryHandle& Handle);
+
+	// keeps the compiled plans, they only depend on the query
+	void Clear();
+
+	// drops the compiled plans, needed once types were reloaded
+	void ResetPlans() { Plans.Reset(); }
+
+	// E_UNDEFINED if the entry is not part of the view
+	EBA_EEntryStatus GetStatus(const FBA_FEntryHandle& Handle) const;
+
+	bool IsVisible(const FBA_FEntryHandle& Handle) const { return GetStatus(Handle) == EBA_EEntryStatus::E_Filtered_Visible; }
+
+	int32 NumVisible() const { return VisibleCount; }
+
+	// visible entries by the slot of their handle, the row layout of FBA_FColumnStore
+	const TBitArray<>& GetVisibleSlots() const { return VisibleSlots; }
+
+	int32 Num() const { return Statuses.Num(); }
+
+	const FBA_FQuery& GetQuery() const { return Query; }
+
+private:
+
+	FBA_FQuery Query;
+
+	// keyed by TObjectKey, so a new type at the address of a collected one does not reuse its plan
+	TMap<TObjectKey<UStruct>, FBA_FQueryPlan> Plans;
+
+	TMap<FBA_FEntryHandle, EBA_EEntryStatus> Statuses;
+
+	TBitArray<> VisibleSlots;
+
+	int32 VisibleCount = 0;
+};
@@ -0,0 +1,70 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "FFAStructs/FBA_FSlotMap.h"
+
+/**
+* Ordered index over the values of one numeric property of a FBA_FFA_ObjectArray.
+* Values and handles are stored in one sorted array, so range scans and rank lookups are a binary search plus
+* a linear read of the result. Entries are inserted and removed per add, remove and change, nothing is replicated.
+*/
+struct BA_REPARRAY_API FBA_FRangeIndex
+{
+public:
+
+	struct FEntry
+	{
+		double Value = 0;
+		FBA_FEntryHandle Handle;
+	};
+
+	FBA_FRangeIndex() = default;
+	explicit FBA_FRangeIndex(FName InPropertyName) : PropertyName(InPropertyName) { }
+
+	FName GetPropertyName() const { return PropertyName; }
+
+	// replaces the content of the index, sorted once
+	void Reset(TArray<FEntry>&& InEntries);
+
+	// adds the entry or moves it to the position of its new value
+	void Set(const FBA_FEntryHandle& Handle, double Value);
+
+	bool Remove(const FBA_FEntryHandle& Handle);
+
+	void Clear();
+
+	/**
+	* Handles with Min <= value <= Max in ascending order of the value.
+	* @param MaxCount Stops after this many results, <= 0 returns all
+	*/
+	void GetRange(double Min, double Max, int32 MaxCount, TArray<FBA_FEntryHandle>& OutHandles) const;
+
+	/**
+	* Count handles starting at rank First (0 is the lowest value, or the highest if bDescending).
+	*/
+	void GetByRank(int32 First, int32 Count, bool bDescending, TArray<FBA_FEntryHandle>& OutHandles) const;
+
+	// number of entries with a value below Value
+	int32 GetRank(double Value) const { return LowerBound(Value); }
+
+	const TArray<FEntry>& GetEntries() const { return Entries; }
+
+	int32 Num() const { return Entries.Num(); }
+
+private:
+
+	// first position with a value not below Value
+	int32 LowerBound(double Value) const;
+
+	// first position that is not before Value/Handle
+	int32 LowerBound(double Value, const FBA_FEntryHandle& Handle) const;
+
+	FName PropertyName;
+
+	// sorted by value, equal values by handle
+	TArray<FEntry> Entries;
+
+	// current value of every indexed entry, needed to find it in Entries
+	TMap<FBA_FEntryHandle, double> Values;
+};
@@ -0,0 +1,117 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "FBA_FSlotMap.generated.h"
+
+/**
+* Stable handle of an entry, stays valid while entries move inside the array.
+* Handles are local to the server or client that issued them and are not replicated.
+*/
+USTRUCT(BlueprintType)
+struct BA_REPARRAY_API FBA_FEntryHandle
+{
+	GENERATED_BODY()
+
+	FBA_FEntryHandle() = default;
+	FBA_FEntryHandle(int32 InSlot, uint32 InGeneration) : Slot(InSlot), Generation(InGeneration) { }
+
+	// true if the handle was issued, use FBA_FSlotMap::Find to check if it is still alive
+	bool IsSet() const { return Slot != INDEX_NONE; }
+	int32 GetSlot() const { return Slot; }
+	uint32 GetGeneration() const { return Generation; }
+
+	FString ToString() const
+	{
+		return FString::Printf(TEXT("%d:%u"), Slot, Generation);
+	}
+
+	FORCEINLINE bool operator==(const FBA_FEntryHandle& Other) const
+	{
+		return Slot == Other.Slot && Generation == Other.Generation;
+	}
+
+	FORCEINLINE bool operator!=(const FBA_FEntryHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	friend uint32 GetTypeHash(const FBA_FEntryHandle& Handle)
+	{
+		return HashCombine(GetTypeHash(Handle.Slot), GetTypeHash(Handle.Generation));
+	}
+
+private:
+
+	int32 Slot = INDEX_NONE;
+
+	uint32 Generation = 0;
+};
+
+/**
+* Generational slot map over the positions of a dense array.
+* Slots are reused, every reuse increments the generation, so stale handles are detected in O(1).
+* The owner mirrors every move of its dense array (add, swap remove, compaction, sorting).
+*/
+struct BA_REPARRAY_API FBA_FSlotMap
+{
+public:
+
+	// links the new element at DenseIndex to a free slot
+	FBA_FEntryHandle Add(int32 DenseIndex);
+
+	// dense index of a live handle, INDEX_NONE if the handle is stale
+	int32 Find(const FBA_FEntryHandle& Handle) const;
+
+	// handle of the element at DenseIndex, unset if none is linked
+	FBA_FEntryHandle GetHandle(int32 DenseIndex) const;
+
+	// frees the slot of the element at DenseIndex, the position stays empty until an element is moved there
+	void Remove(int32 DenseIndex);
+
+	// mirrors moving the element at From to the empty position To
+	void Move(int32 From, int32 To);
+
+	// mirrors TArray::RemoveAtSwap
+	void RemoveAtSwap(int32 DenseIndex);
+
+	// shrinks or grows the dense positions, elements beyond NewNum are removed
+	void SetNum(int32 NewNum);
+
+	// links a live handle to a new position, used after reordering the dense array
+	bool Relink(int32 DenseIndex, const FBA_FEntryHandle& Handle);
+
+	// frees all slots, all handles issued so far become stale
+	void Reset();
+
+	void Reserve(int32 Number);
+
+	int32 Num() const { return DenseToSlot.Num(); }
+
+	// number of slots ever issued, live and free
+	int32 NumSlots() const { return Slots.Num(); }
+
+	// handle of the element linked to SlotIndex, unset for free slots
+	FBA_FEntryHandle GetSlotHandle(int32 SlotIndex) const
+	{
+		return Slots.IsValidIndex(SlotIndex) && Slots[SlotIndex].DenseIndex != INDEX_NONE
+			? FBA_FEntryHandle(SlotIndex, Slots[SlotIndex].Generation)
+			: FBA_FEntryHandle();
+	}
+
+private:
+
+	struct FSlot
+	{
+		int32 DenseIndex = INDEX_NONE;
+		uint32 Generation = 0;
+	};
+
+	TArray<FSlot> Slots;
+
+	TArray<int32> FreeSlots;
+
+	// slot of every dense position, INDEX_NONE for empty positions
+	TArray<int32> DenseToSlot;
+};
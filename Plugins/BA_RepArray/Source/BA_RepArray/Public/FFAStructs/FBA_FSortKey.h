@@ -0,0 +1,108 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/**
+* Typed sort key of one entry, extracted once before sorting.
+* Numeric properties compare as numbers, text like properties as strings.
+* NaN has no order and is never equal to itself, it results in a key of type None like a missing value.
+*/
+struct BA_REPARRAY_API FBA_FSortKey
+{
+	enum class EType : uint8
+	{
+		None,
+		Numeric,
+		String,
+	};
+
+	// reads the value of Property in Container, None if Property is null
+	static FBA_FSortKey FromProperty(const FProperty* Property, const void* Container);
+
+	// like FromProperty, but enum values are read as the name of the value
+	static FBA_FSortKey FromPropertyValue(const FProperty* Property, const void* Container);
+
+	static FBA_FSortKey FromNumber(double Number)
+	{
+		FBA_FSortKey Key;
+		if (FMath::IsNaN(Number))
+		{
+			return Key;
+		}
+		Key.Type = EType::Numeric;
+		Key.Number = Number;
+		return Key;
+	}
+
+	static FBA_FSortKey FromString(const FString& String)
+	{
+		FBA_FSortKey Key;
+		Key.Type = EType::String;
+		Key.String = String;
+		return Key;
+	}
+
+	EType GetType() const { return Type; }
+	double GetNumber() const { return Number; }
+	const FString& GetString() const { return String; }
+
+	// numbers before strings, entries without a key last
+	friend bool operator<(const FBA_FSortKey& A, const FBA_FSortKey& B)
+	{
+		if (A.Type != B.Type)
+		{
+			return B.Type == EType::None || (A.Type == EType::Numeric && B.Type == EType::String);
+		}
+		switch (A.Type)
+		{
+		case EType::Numeric:
+			return A.Number < B.Number;
+		case EType::String:
+			return A.String < B.String;
+		default:
+			return false;
+		}
+	}
+
+	// same type and value, strings compare case insensitive like operator<
+	friend bool operator==(const FBA_FSortKey& A, const FBA_FSortKey& B)
+	{
+		if (A.Type != B.Type)
+		{
+			return false;
+		}
+		switch (A.Type)
+		{
+		case EType::Numeric:
+			return A.Number == B.Number;
+		case EType::String:
+			return A.String == B.String;
+		default:
+			return true;
+		}
+	}
+
+	friend uint32 GetTypeHash(const FBA_FSortKey& Key)
+	{
+		switch (Key.Type)
+		{
+		case EType::Numeric:
+			// 0.0 and -0.0 are equal
+			return Key.Number == 0 ? 0 : GetTypeHash(Key.Number);
+		case EType::String:
+			return GetTypeHash(Key.String);
+		default:
+			return 0;
+		}
+	}
+
+private:
+
+	EType Type = EType::None;
+
+	double Number = 0;
+
+	FString String;
+};
@@ -0,0 +1,65 @@
+// Copyright Developer Bastian 2024. Contact: developer.bastian@gmail.com or https://discord.gg/8JStx9XZGP. License Creative Commons 4.0 DEED (https://creativecommons.org/licenses/by/4.0/deed.en).
+
+#pragma once
+#include "CoreMinimal.h"
+#include "FFAStructs/FBA_FSlotMap.h"
+#include "FFAStructs/FBA_FSortKey.h"
+
+/**
+* Local sort order of the entries of a FBA_FFA_ObjectArray, the array itself is not reordered and nothing is replicated.
+* Stores the entry handles ordered by their key and is updated per entry on add, remove and change.
+*/
+struct BA_REPARRAY_API FBA_FSortedView
+{
+public:
+
+	FBA_FSortedView() = default;
+	// PropertyName None sorts by the index the entries were added with
+	FBA_FSortedView(FName InPropertyName, bool bInDescending, const TArray<FString>& InSortableTypes)
+		: PropertyName(InPropertyName), bDescending(bInDescending), SortableTypes(InSortableTypes) { }
+
+	FName GetPropertyName() const { return PropertyName; }
+	bool SortsByIndex() const { return PropertyName.IsNone(); }
+	bool IsDescending() const { return bDescending; }
+	const TArray<FString>& GetSortableTypes() const { return SortableTypes; }
+
+	// replaces the content of the view, sorted once
+	void Reset(TArray<TPair<FBA_FEntryHandle, FBA_FSortKey>>&& Entries);
+
+	void Insert(const FBA_FEntryHandle& Handle, FBA_FSortKey&& Key);
+
+	bool Remove(const FBA_FEntryHandle& Handle);
+
+	// moves the entry to the position of its new key, returns false if the key did not change
+	bool Update(const FBA_FEntryHandle& Handle, FBA_FSortKey&& Key);
+
+	void Clear();
+
+	const TArray<FBA_FEntryHandle>& GetHandles() const { return Handles; }
+
+	// position of Handle in the view, INDEX_NONE if not part of it
+	int32 IndexOf(const FBA_FEntryHandle& Handle) const;
+
+	int32 Num() const { return Handles.Num(); }
+
+private:
+
+	// strict weak order over key and handle, entries without a key stay last in both directions
+	bool IsBefore(const FBA_FSortKey& KeyA, const FBA_FEntryHandle& HandleA, const FBA_FSortKey& KeyB, const FBA_FEntryHandle& HandleB) const;
+
+	// first position that is not before Key/Handle
+	int32 LowerBound(const FBA_FSortKey& Key, const FBA_FEntryHandle& Handle) const;
+
+	// position of Handle with its stored Key, falls back to a linear search if the order is broken
+	int32 FindPosition(const FBA_FEntryHandle& Handle, const FBA_FSortKey& Key) const;
+
+	FName PropertyName;
+
+	bool bDescending = false;
+
+	TArray<FString> SortableTypes;
+
+	TArray<FBA_FEntryHandle> Handles;
+
+	TMap<FBA_FEntryHandle, FBA_FSortKey> Keys;
+};